@@ -0,0 +1,663 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+// eytzinger_set is a read-mostly sibling of flat_set. It offers the same
+// lookup and ordered-iteration interface, but keeps its keys in the
+// breadth-first order of an implicit binary search tree (the "Eytzinger"
+// layout): the root is stored first, then both children of the root, then
+// the four grandchildren, and so on. The first few levels of every search
+// therefore share a handful of cache lines, and the descendants four levels
+// down from any node are contiguous and can be prefetched.
+//
+// The layout is rebuilt in bulk, in O(n log n), by the constructors and by
+// the range forms of insert(). There are no single-element insert or erase
+// operations; batch changes up, or use flat_set if the set is write-heavy.
+
+#include <stddef.h>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "flat_detail.h"
+
+namespace stdext {
+
+namespace eytzinger_detail {
+    template<class It>
+    using is_random_access_iterator = std::is_convertible<
+        typename std::iterator_traits<It>::iterator_category,
+        std::random_access_iterator_tag
+    >;
+
+    // Nodes are numbered from 1 in breadth-first order, so the children of
+    // node k are 2k and 2k+1, and node k is stored at offset k-1. Node 0 is
+    // the past-the-end position.
+    inline size_t first_index(size_t n) {
+        size_t k = (n != 0) ? 1 : 0;
+        while (k != 0 && 2 * k <= n) {
+            k = 2 * k;
+        }
+        return k;
+    }
+
+    inline size_t last_index(size_t n) {
+        size_t k = (n != 0) ? 1 : 0;
+        while (k != 0 && 2 * k + 1 <= n) {
+            k = 2 * k + 1;
+        }
+        return k;
+    }
+
+    inline size_t next_index(size_t k, size_t n) {
+        if (2 * k + 1 <= n) {
+            // Leftmost node of the right subtree.
+            k = 2 * k + 1;
+            while (2 * k <= n) {
+                k = 2 * k;
+            }
+            return k;
+        }
+        // Climb past every ancestor we are the right child of; the next
+        // one up is the successor, or 0 if we were the rightmost node.
+        while (k & 1) {
+            k >>= 1;
+        }
+        return k >> 1;
+    }
+
+    inline size_t prev_index(size_t k, size_t n) {
+        if (k == 0) {
+            return last_index(n);
+        }
+        if (2 * k <= n) {
+            // Rightmost node of the left subtree.
+            k = 2 * k;
+            while (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+            }
+            return k;
+        }
+        while (k != 0 && !(k & 1)) {
+            k >>= 1;
+        }
+        return k >> 1;
+    }
+
+    // How far ahead of the current node to prefetch: the descendants that
+    // many positions down are contiguous and about one cache line long.
+    template<class Key>
+    struct prefetch_stride : std::integral_constant<size_t,
+        (sizeof(Key) <= 4) ? 16 : (sizeof(Key) <= 8) ? 8 : (sizeof(Key) <= 16) ? 4 : (sizeof(Key) <= 32) ? 2 : 1
+    > {};
+
+    // Moves the element at c[from[i]] into c[i] for every i, following each
+    // cycle of the permutation once. "from" is consumed.
+    template<class Container>
+    void gather(Container& c, std::vector<size_t>& from, std::true_type) {
+        for (size_t i = 0; i < from.size(); ++i) {
+            if (from[i] == i) {
+                continue;
+            }
+            typename Container::value_type tmp = std::move(c[i]);
+            size_t j = i;
+            while (from[j] != i) {
+                size_t next = from[j];
+                c[j] = std::move(c[next]);
+                from[j] = j;
+                j = next;
+            }
+            c[j] = std::move(tmp);
+            from[j] = j;
+        }
+    }
+
+    // Keys that can be moved without throwing are permuted in place; others
+    // are copied into a new container, so that a throw leaves c as it was.
+    template<class T>
+    using moves_in_place = std::integral_constant<bool,
+        (std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) ||
+        !std::is_copy_constructible<T>::value
+    >;
+
+    // A copy of c with the element at c[from[i]] at position i.
+    template<class Container>
+    Container gathered_copy(const Container& c, const std::vector<size_t>& from) {
+        Container result = flat_detail::make_empty_like(c);
+        flat_detail::reserve_if_possible(result, from.size());
+        for (size_t i = 0; i < from.size(); ++i) {
+            result.insert(result.end(), c[from[i]]);
+        }
+        return result;
+    }
+
+    template<class Container>
+    void gather(Container& c, std::vector<size_t>& from, std::false_type) {
+        c = eytzinger_detail::gathered_copy(c, from);
+    }
+
+    template<class Container>
+    void gather(Container& c, std::vector<size_t>& from) {
+        eytzinger_detail::gather(c, from, moves_in_place<typename Container::value_type>());
+    }
+
+    template<class KeyContainer>
+    class iter {
+    public:
+        using difference_type = ptrdiff_t;
+        using value_type = typename KeyContainer::value_type;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iter() = default;
+        explicit iter(const KeyContainer *c, size_t k) : c_(c), k_(k) {}
+
+        reference operator*() const { return (*c_)[k_ - 1]; }
+        pointer operator->() const { return std::addressof((*c_)[k_ - 1]); }
+
+        iter& operator++() { k_ = eytzinger_detail::next_index(k_, c_->size()); return *this; }
+        iter& operator--() { k_ = eytzinger_detail::prev_index(k_, c_->size()); return *this; }
+        iter operator++(int) { iter result = *this; ++*this; return result; }
+        iter operator--(int) { iter result = *this; --*this; return result; }
+
+        friend bool operator==(const iter& a, const iter& b) { return a.k_ == b.k_; }
+        friend bool operator!=(const iter& a, const iter& b) { return a.k_ != b.k_; }
+
+    private:
+        const KeyContainer *c_ = nullptr;
+        size_t k_ = 0;
+    };
+} // namespace eytzinger_detail
+
+#ifndef STDEXT_HAS_SORTED_UNIQUE
+#define STDEXT_HAS_SORTED_UNIQUE
+
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+
+#if defined(__cpp_inline_variables)
+inline
+#endif
+constexpr sorted_unique_t sorted_unique {};
+
+#endif // STDEXT_HAS_SORTED_UNIQUE
+
+template<
+    class Key,
+    class Compare = std::less<Key>,
+    class KeyContainer = std::vector<Key>
+>
+class eytzinger_set {
+    static_assert(eytzinger_detail::is_random_access_iterator<typename KeyContainer::iterator>::value, "");
+    static_assert(std::is_same<Key, typename KeyContainer::value_type>::value, "");
+    static_assert(std::is_convertible<decltype(std::declval<const Compare&>()(std::declval<const Key&>(), std::declval<const Key&>())), bool>::value, "");
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+    using value_type = Key;
+    using value_compare = Compare;
+    using reference = const Key&;
+    using const_reference = const Key&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = eytzinger_detail::iter<KeyContainer>;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator;
+    using container_type = KeyContainer;
+
+// =========================================================== CONSTRUCTORS
+
+    eytzinger_set() : eytzinger_set(Compare()) {}
+
+    explicit eytzinger_set(const Compare& comp)
+        : c_(), compare_(comp) {}
+
+    explicit eytzinger_set(KeyContainer ctr, const Compare& comp = Compare())
+        : c_(static_cast<KeyContainer&&>(ctr)), compare_(comp)
+    {
+        this->sort_and_unique_impl();
+        this->layout_impl();
+    }
+
+    eytzinger_set(sorted_unique_t, KeyContainer ctr, const Compare& comp = Compare())
+        : c_(static_cast<KeyContainer&&>(ctr)), compare_(comp)
+    {
+        this->layout_impl();
+    }
+
+    template<class InputIterator>
+    eytzinger_set(InputIterator first, InputIterator last, const Compare& comp = Compare())
+        : c_(first, last), compare_(comp)
+    {
+        this->sort_and_unique_impl();
+        this->layout_impl();
+    }
+
+    template<class InputIterator>
+    eytzinger_set(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare())
+        : c_(first, last), compare_(comp)
+    {
+        this->layout_impl();
+    }
+
+    eytzinger_set(std::initializer_list<Key> il, const Compare& comp = Compare())
+        : eytzinger_set(il.begin(), il.end(), comp) {}
+
+    eytzinger_set(sorted_unique_t s, std::initializer_list<Key> il, const Compare& comp = Compare())
+        : eytzinger_set(s, il.begin(), il.end(), comp) {}
+
+// ========================================================== OTHER MEMBERS
+
+    eytzinger_set& operator=(std::initializer_list<Key> il) {
+        this->clear();
+        this->insert(il);
+        return *this;
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(&c_, eytzinger_detail::first_index(c_.size())); }
+    const_iterator end() const noexcept { return const_iterator(&c_, 0); }
+
+    const_iterator cbegin() const noexcept { return this->begin(); }
+    const_iterator cend() const noexcept { return this->end(); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+#if __cplusplus >= 201703L
+    [[nodiscard]]
+#endif
+    bool empty() const noexcept { return c_.empty(); }
+    size_type size() const noexcept { return c_.size(); }
+    size_type max_size() const noexcept { return c_.max_size(); }
+
+    // If the comparator or a key's copy throws, the set is left as it was.
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        KeyContainer s = this->sorted_keys_impl(moves_in_place());
+        size_type old_size = s.size();
+        try {
+            s.insert(s.end(), first, last);
+            std::stable_sort(s.begin() + old_size, s.end(), compare_);
+            this->merge_impl(s, old_size);
+        } catch (...) {
+            this->restore_impl(s, old_size, moves_in_place());
+            throw;
+        }
+        this->commit_impl(s);
+    }
+
+    template<class InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        KeyContainer s = this->sorted_keys_impl(moves_in_place());
+        size_type old_size = s.size();
+        try {
+            s.insert(s.end(), first, last);
+            this->merge_impl(s, old_size);
+        } catch (...) {
+            this->restore_impl(s, old_size, moves_in_place());
+            throw;
+        }
+        this->commit_impl(s);
+    }
+
+    void insert(std::initializer_list<Key> il) {
+        this->insert(il.begin(), il.end());
+    }
+
+    void insert(sorted_unique_t s, std::initializer_list<Key> il) {
+        this->insert(s, il.begin(), il.end());
+    }
+
+    // Returns the keys in sorted order.
+    KeyContainer extract() && {
+        this->sorted_order_impl();
+        KeyContainer result = static_cast<KeyContainer&&>(c_);
+        clear();
+        return result;
+    }
+
+    // The keys in ctr must already be sorted and unique.
+    void replace(KeyContainer&& ctr) {
+        c_ = static_cast<KeyContainer&&>(ctr);
+        this->layout_impl();
+    }
+
+    void swap(eytzinger_set& m) noexcept
+#if defined(__cpp_lib_is_swappable)
+        (std::is_nothrow_swappable<KeyContainer>::value && std::is_nothrow_swappable<Compare>::value)
+#endif
+    {
+        using std::swap;
+        swap(compare_, m.compare_);
+        swap(c_, m.c_);
+    }
+
+    void clear() noexcept {
+        c_.clear();
+    }
+
+    Compare key_comp() const { return compare_; }
+    Compare value_comp() const { return compare_; }
+
+    const_iterator find(const Key& t) const {
+        auto it = this->lower_bound(t);
+        if (it == this->end() || compare_(t, *it)) {
+            return this->end();
+        }
+        return it;
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    const_iterator find(const K& x) const {
+        auto it = this->lower_bound(x);
+        if (it == this->end() || compare_(x, *it)) {
+            return this->end();
+        }
+        return it;
+    }
+
+    size_type count(const Key& x) const {
+        return this->contains(x) ? 1 : 0;
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    size_type count(const K& x) const {
+        return this->contains(x) ? 1 : 0;
+    }
+
+    bool contains(const Key& x) const {
+        return this->find(x) != this->end();
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    bool contains(const K& x) const {
+        return this->find(x) != this->end();
+    }
+
+    const_iterator lower_bound(const Key& t) const {
+        return this->search_impl([&](const Key& elt) {
+            return bool(compare_(elt, t));
+        });
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    const_iterator lower_bound(const K& x) const {
+        return this->search_impl([&](const Key& elt) {
+            return bool(compare_(elt, x));
+        });
+    }
+
+    const_iterator upper_bound(const Key& t) const {
+        return this->search_impl([&](const Key& elt) {
+            return !bool(compare_(t, elt));
+        });
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    const_iterator upper_bound(const K& x) const {
+        return this->search_impl([&](const Key& elt) {
+            return !bool(compare_(x, elt));
+        });
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& t) const {
+        auto lo = this->lower_bound(t);
+        auto hi = lo;
+        if (hi != this->end() && !bool(compare_(t, *hi))) {
+            ++hi;
+        }
+        return { lo, hi };
+    }
+
+    template<class K,
+             class Compare_ = Compare, class = typename Compare_::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& x) const {
+        return { this->lower_bound(x), this->upper_bound(x) };
+    }
+
+private:
+    // Descends from the root, going right whenever goes_right(node) holds.
+    // The step is computed rather than branched on, so the search costs no
+    // mispredictions. The answer is the last node where the search went
+    // left: strip the trailing right turns, then that left turn.
+    template<class Pred>
+    const_iterator search_impl(const Pred& goes_right) const {
+        const size_t n = c_.size();
+        const size_t stride = eytzinger_detail::prefetch_stride<Key>::value;
+        size_t k = 1;
+        while (k <= n) {
+#if defined(__GNUC__)
+            __builtin_prefetch(std::addressof(c_[std::min(k * stride, n) - 1]));
+#endif
+            k = 2 * k + (goes_right(c_[k - 1]) ? 1 : 0);
+        }
+#if defined(__GNUC__)
+        k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+#else
+        while (k & 1) {
+            k >>= 1;
+        }
+        k >>= 1;
+#endif
+        return const_iterator(&c_, k);
+    }
+
+    void sort_and_unique_impl() {
+        std::stable_sort(c_.begin(), c_.end(), compare_);
+        this->unique_impl();
+    }
+
+    // Keeps the first of each run of equivalent keys.
+    void unique_impl() {
+        auto it = std::unique(c_.begin(), c_.end(), [&](const Key& a, const Key& b) {
+            return !bool(compare_(a, b));
+        });
+        c_.erase(it, c_.end());
+    }
+
+    using moves_in_place = eytzinger_detail::moves_in_place<Key>;
+
+    // [0, old_size) and [old_size, s.size()) are each sorted; merge them,
+    // keeping existing keys over new equivalent ones and the first of several
+    // equivalent new ones. Every comparison is made before an existing key
+    // moves, so if the comparator throws, [0, old_size) is still intact.
+    void merge_impl(KeyContainer& s, size_type old_size) {
+        KeyContainer new_keys = flat_detail::make_empty_like(s);
+        flat_detail::reserve_if_possible(new_keys, s.size() - old_size);
+        std::vector<size_t> positions;
+        positions.reserve(s.size() - old_size);
+        auto mid = s.begin() + old_size;
+        auto it = s.begin();
+        for (auto tail = mid; tail != s.end(); ++tail) {
+            auto&& t = *tail;
+            it = std::partition_point(it, mid, [&](const Key& elt) {
+                return bool(compare_(elt, t));
+            });
+            if ((it == mid || bool(compare_(t, *it))) &&
+                (new_keys.empty() || bool(compare_(*(new_keys.end() - 1), t)))) {
+                new_keys.insert(new_keys.end(), std::move(t));
+                positions.push_back(static_cast<size_t>(it - s.begin()));
+            }
+        }
+
+        size_type new_size = old_size + new_keys.size();
+        s.erase(s.begin() + new_size, s.end());
+        size_t i = old_size;
+        auto out = s.begin() + new_size;
+        for (size_t j = new_keys.size(); j != 0; --j) {
+            while (i != positions[j - 1]) {
+                --i;
+                *--out = std::move(s[i]);
+            }
+            *--out = std::move(new_keys[j - 1]);
+        }
+    }
+
+    // The keys in sorted order, in a container for an insert to work on.
+    // Keys that move without throwing are moved out of c_; others are
+    // copied, so that c_ still holds the set if the insert fails.
+    KeyContainer sorted_keys_impl(std::true_type) {
+        KeyContainer s = static_cast<KeyContainer&&>(c_);
+        c_.clear();
+        try {
+            eytzinger_set::sort_keys(s);
+        } catch (...) {
+            c_ = static_cast<KeyContainer&&>(s);
+            throw;
+        }
+        return s;
+    }
+
+    KeyContainer sorted_keys_impl(std::false_type) const {
+        return eytzinger_detail::gathered_copy(c_, eytzinger_set::sorted_order(c_.size()));
+    }
+
+    // After a failed insert, the first old_size keys of s are the set's
+    // keys, still sorted; lay them out again. Copied keys are simply dropped.
+    void restore_impl(KeyContainer& s, size_type old_size, std::true_type) {
+        s.erase(s.begin() + old_size, s.end());
+        this->commit_impl(s);
+    }
+
+    void restore_impl(KeyContainer&, size_type, std::false_type) {}
+
+    // s is sorted; lay it out and make it the set's keys.
+    void commit_impl(KeyContainer& s) {
+        eytzinger_set::layout_keys(s);
+        c_ = static_cast<KeyContainer&&>(s);
+    }
+
+    // from[i] is the sorted rank of the key at node i+1.
+    static std::vector<size_t> layout_order(size_t n) {
+        std::vector<size_t> from(n);
+        size_t r = 0;
+        for (size_t k = eytzinger_detail::first_index(n); k != 0; k = eytzinger_detail::next_index(k, n)) {
+            from[k - 1] = r++;
+        }
+        return from;
+    }
+
+    // from[r] is the offset of the node holding the r-th smallest key.
+    static std::vector<size_t> sorted_order(size_t n) {
+        std::vector<size_t> from(n);
+        size_t r = 0;
+        for (size_t k = eytzinger_detail::first_index(n); k != 0; k = eytzinger_detail::next_index(k, n)) {
+            from[r++] = k - 1;
+        }
+        return from;
+    }
+
+    // Permutes sorted keys into breadth-first order: the node visited r-th
+    // by an in-order walk receives the r-th smallest key. A throw leaves c
+    // as it was.
+    static void layout_keys(KeyContainer& c) {
+        std::vector<size_t> from = eytzinger_set::layout_order(c.size());
+        eytzinger_detail::gather(c, from);
+    }
+
+    // The inverse of layout_keys. A throw leaves c as it was.
+    static void sort_keys(KeyContainer& c) {
+        std::vector<size_t> from = eytzinger_set::sorted_order(c.size());
+        eytzinger_detail::gather(c, from);
+    }
+
+    // c_ is sorted; lay it out. A sorted c_ is not a valid layout, so if
+    // that throws the set is cleared.
+    void layout_impl() {
+        try {
+            eytzinger_set::layout_keys(c_);
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+    }
+
+    // Put c_ back into sorted order.
+    void sorted_order_impl() {
+        eytzinger_set::sort_keys(c_);
+    }
+
+    KeyContainer c_;
+    Compare compare_;
+};
+
+template<class Key, class Compare, class KeyContainer>
+bool operator==(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator!=(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return !(x == y);
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator<(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator>(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return (y < x);
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator<=(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return !(y < x);
+}
+
+template<class Key, class Compare, class KeyContainer>
+bool operator>=(const eytzinger_set<Key, Compare, KeyContainer>& x, const eytzinger_set<Key, Compare, KeyContainer>& y)
+{
+    return !(x < y);
+}
+
+template<class Key, class Compare, class KeyContainer>
+void swap(eytzinger_set<Key, Compare, KeyContainer>& x, eytzinger_set<Key, Compare, KeyContainer>& y) noexcept(noexcept(x.swap(y)))
+{
+    return x.swap(y);
+}
+
+} // namespace stdext
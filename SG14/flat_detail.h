@@ -0,0 +1,154 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+// Helpers shared by flat_map and flat_set: the lower_bound they search with,
+// and the container plumbing their bulk inserts use, which eytzinger_set
+// shares too. Arithmetic keys in a
+// std::vector, ordered by std::less, take a branchless search; everything
+// else uses std::partition_point.
+
+#include <stddef.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace stdext {
+
+namespace flat_detail {
+    template<int I> struct priority_tag : priority_tag<I-1> {};
+    template<> struct priority_tag<0> {};
+
+    // Branchless lower_bound over a sorted array of arithmetic keys. The
+    // binary search runs without data-dependent branches until the range
+    // fits in a couple of cache lines, prefetching both possible next probes,
+    // and then counts the smaller keys in a simple loop that compilers turn
+    // into SIMD compares where available.
+    template<class T>
+    const T *arithmetic_lower_bound(const T *first, size_t n, T key) {
+        constexpr size_t window = (128 / sizeof(T) > 4) ? 128 / sizeof(T) : 4;
+        while (n > window) {
+            size_t half = n / 2;
+#if defined(__GNUC__)
+            __builtin_prefetch(first + (n - half) / 2);
+            __builtin_prefetch(first + half + (n - half) / 2);
+#endif
+            first = (first[half] < key) ? first + half : first;
+            n -= half;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += (first[i] < key) ? 1 : 0;
+        }
+        return first + count;
+    }
+
+    template<class T, class Compare>
+    using is_arithmetic_less = std::integral_constant<bool,
+        std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+        (std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value)
+    >;
+
+    template<class Container, class Key, class Compare>
+    size_t lower_bound_index(const Container& c, const Key& k, Compare& compare, priority_tag<0>) {
+        auto it = std::partition_point(c.begin(), c.end(), [&](const Key& elt) {
+            return bool(compare(elt, k));
+        });
+        return static_cast<size_t>(it - c.begin());
+    }
+
+    template<class T, class A, class Compare,
+             class = typename std::enable_if<is_arithmetic_less<T, typename std::remove_const<Compare>::type>::value>::type>
+    size_t lower_bound_index(const std::vector<T, A>& c, const T& k, Compare&, priority_tag<1>) {
+        const T *first = c.data();
+        return static_cast<size_t>(flat_detail::arithmetic_lower_bound(first, c.size(), k) - first);
+    }
+
+    template<class Container, class Key, class Compare>
+    size_t lower_bound_index(const Container& c, const Key& k, Compare& compare) {
+        return flat_detail::lower_bound_index(c, k, compare, priority_tag<1>());
+    }
+
+    // An empty container of the same type as c, using c's allocator if it has one.
+    template<class Container>
+    auto make_empty_like(const Container& c, priority_tag<1>) -> decltype(Container(c.get_allocator())) {
+        return Container(c.get_allocator());
+    }
+    template<class Container>
+    Container make_empty_like(const Container&, priority_tag<0>) {
+        return Container();
+    }
+    template<class Container>
+    Container make_empty_like(const Container& c) {
+        return flat_detail::make_empty_like(c, priority_tag<1>());
+    }
+
+    template<class Container>
+    auto reserve_if_possible(Container& c, size_t n, priority_tag<1>) -> decltype(void(c.reserve(n))) {
+        c.reserve(n);
+    }
+    template<class Container>
+    void reserve_if_possible(Container&, size_t, priority_tag<0>) {}
+    template<class Container>
+    void reserve_if_possible(Container& c, size_t n) {
+        flat_detail::reserve_if_possible(c, n, priority_tag<1>());
+    }
+
+    // Makes room for n more elements, growing geometrically so that a run of
+    // small bulk inserts still reallocates only a logarithmic number of times.
+    template<class Container>
+    auto reserve_more_if_possible(Container& c, size_t n, priority_tag<1>) -> decltype(void(c.reserve(c.capacity()))) {
+        if (c.capacity() - c.size() < n) {
+            c.reserve((std::max)(c.size() + n, 2 * c.size()));
+        }
+    }
+    template<class Container>
+    void reserve_more_if_possible(Container&, size_t, priority_tag<0>) {}
+    template<class Container>
+    void reserve_more_if_possible(Container& c, size_t n) {
+        flat_detail::reserve_more_if_possible(c, n, priority_tag<1>());
+    }
+
+    // The length of [first, last) if it can be counted without consuming it, or 0.
+    template<class It>
+    size_t range_size_hint(It, It, std::input_iterator_tag) {
+        return 0;
+    }
+    template<class It>
+    size_t range_size_hint(It first, It last, std::forward_iterator_tag) {
+        return static_cast<size_t>(std::distance(first, last));
+    }
+    template<class It>
+    size_t range_size_hint(It first, It last) {
+        return flat_detail::range_size_hint(first, last, typename std::iterator_traits<It>::iterator_category());
+    }
+
+} // namespace flat_detail
+
+} // namespace stdext
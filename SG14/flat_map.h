@@ -34,8 +34,11 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <numeric>
 #include <vector>
 
+#include "flat_detail.h"
+
 namespace stdext {
 
 namespace flatmap_detail {
@@ -188,6 +191,13 @@ namespace flatmap_detail {
         return dfirst;
     }
 
+    // The offsets 0, 1, ..., n-1, for merging a tail that is already sorted.
+    struct identity_order {
+        size_t n;
+        size_t size() const { return n; }
+        size_t operator[](size_t i) const { return i; }
+    };
+
     template<class, class> class iter;
     template<class K, class V> iter<K, V> make_iterator(K, V);
 
@@ -430,11 +440,7 @@ public:
     flat_map(InputIterator first, InputIterator last, const Compare& comp = Compare())
         : compare_(comp)
     {
-        for (; first != last; ++first) {
-            c_.keys.insert(c_.keys.end(), first->first);
-            // TODO: we must make this exception-safe if the container insert throws
-            c_.values.insert(c_.values.end(), first->second);
-        }
+        this->append_impl(first, last);
         this->sort_and_unique_impl();
     }
 
@@ -445,10 +451,7 @@ public:
     flat_map(InputIterator first, InputIterator last, const Compare& comp, const Alloc& a)
         : c_{flatmap_detail::make_obj_using_allocator<KeyContainer>(a), flatmap_detail::make_obj_using_allocator<MappedContainer>(a)}, compare_(comp)
     {
-        for (; first != last; ++first) {
-            c_.keys.insert(c_.keys.end(), first->first);
-            c_.values.insert(c_.values.end(), first->second);
-        }
+        this->append_impl(first, last);
         this->sort_and_unique_impl();
     }
 
@@ -464,10 +467,7 @@ public:
     flat_map(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare())
         : compare_(comp)
     {
-        for (; first != last; ++first) {
-            c_.keys.insert(c_.keys.end(), first->first);
-            c_.values.insert(c_.values.end(), first->second);
-        }
+        this->append_impl(first, last);
     }
 
     template<class InputIterator, class Alloc,
@@ -477,10 +477,7 @@ public:
     flat_map(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp, const Alloc& a)
         : c_{flatmap_detail::make_obj_using_allocator<KeyContainer>(a), flatmap_detail::make_obj_using_allocator<MappedContainer>(a)}, compare_(comp)
     {
-        for (; first != last; ++first) {
-            c_.keys.insert(c_.keys.end(), first->first);
-            c_.values.insert(c_.values.end(), first->second);
-        }
+        this->append_impl(first, last);
     }
 
     template<class InputIterator, class Alloc,
@@ -637,30 +634,42 @@ public:
     template<class InputIterator,
              class = typename std::enable_if<flatmap_detail::qualifies_as_input_iterator<InputIterator>::value>::type>
     void insert(InputIterator first, InputIterator last) {
-        // TODO: if we're inserting lots of elements, stick them at the end and then sort
-        while (first != last) {
-            this->insert(*first);
-            ++first;
+        // Stick the new elements at the end, sort them (by index, so that the
+        // first of several equivalent keys wins, as with one-at-a-time insertion),
+        // and then merge them into the existing elements.
+        // Until the merge starts, a throw only has to drop the new tail.
+        size_type old_size = this->size();
+        std::vector<size_type> order;
+        try {
+            this->append_impl(first, last);
+            auto kfirst = c_.keys.begin() + old_size;
+            order.resize(this->size() - old_size);
+            std::iota(order.begin(), order.end(), size_type(0));
+            std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return bool(compare_(*(kfirst + a), *(kfirst + b)));
+            });
+            order.erase(std::unique(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return !bool(compare_(*(kfirst + a), *(kfirst + b)));
+            }), order.end());
+        } catch (...) {
+            this->truncate_impl(old_size);
+            throw;
         }
+        this->merge_tail_impl(old_size, order);
     }
 
     template<class InputIterator,
              class = typename std::enable_if<flatmap_detail::qualifies_as_input_iterator<InputIterator>::value>::type>
     void insert(stdext::sorted_unique_t, InputIterator first, InputIterator last) {
-        // TODO: if InputIterator is bidirectional, this loop should (go backward??)
-        // TODO: if we're inserting lots of elements, stick them at the end and then sort
-        auto it = begin();
-        while (first != last) {
-            std::pair<Key, Mapped> t(*first);
-            it = std::partition_point(it, this->end(), [&](const auto& elt) {
-                return bool(compare_(elt.first, t.first));
-            });
-            if (it == this->end() || bool(compare_(t.first, it->first))) {
-                it = this->emplace(it, std::move(t));
-            }
-            ++it;
-            ++first;
+        // The containers grow once, and the merge fills them from the back.
+        size_type old_size = this->size();
+        try {
+            this->append_impl(first, last);
+        } catch (...) {
+            this->truncate_impl(old_size);
+            throw;
         }
+        this->merge_tail_impl(old_size, flatmap_detail::identity_order{this->size() - old_size});
     }
 
     void insert(std::initializer_list<value_type> il) {
@@ -699,8 +708,9 @@ public:
 
     template<class... Args>
     std::pair<iterator, bool> try_emplace(const Key& k, Args&&... args) {
-        auto kit = std::lower_bound(c_.keys.begin(), c_.keys.end(), k, std::ref(compare_));
-        auto vit = c_.values.begin() + (kit - c_.keys.begin());
+        auto idx = flat_detail::lower_bound_index(c_.keys, k, compare_);
+        auto kit = c_.keys.begin() + idx;
+        auto vit = c_.values.begin() + idx;
         if (kit == c_.keys.end() || compare_(k, *kit)) {
             kit = c_.keys.insert(kit, k);
             // TODO: we must make this exception-safe if the container throws
@@ -713,8 +723,9 @@ public:
 
     template<class... Args>
     std::pair<iterator, bool> try_emplace(Key&& k, Args&&... args) {
-        auto kit = std::lower_bound(c_.keys.begin(), c_.keys.end(), k, std::ref(compare_));
-        auto vit = c_.values.begin() + (kit - c_.keys.begin());
+        auto idx = flat_detail::lower_bound_index(c_.keys, k, compare_);
+        auto kit = c_.keys.begin() + idx;
+        auto vit = c_.values.begin() + idx;
         if (kit == c_.keys.end() || compare_(k, *kit)) {
             kit = c_.keys.insert(kit, static_cast<Key&&>(k));
             // TODO: we must make this exception-safe if the container throws
@@ -910,19 +921,13 @@ public:
     }
 
     iterator lower_bound(const Key& k) {
-        auto kit = std::partition_point(c_.keys.begin(), c_.keys.end(), [&](const auto& elt) {
-            return bool(compare_(elt, k));
-        });
-        auto vit = c_.values.begin() + (kit - c_.keys.begin());
-        return flatmap_detail::make_iterator(kit, vit);
+        auto idx = flat_detail::lower_bound_index(c_.keys, k, compare_);
+        return flatmap_detail::make_iterator(c_.keys.cbegin() + idx, c_.values.begin() + idx);
     }
 
     const_iterator lower_bound(const Key& k) const {
-        auto kit = std::partition_point(c_.keys.begin(), c_.keys.end(), [&](const auto& elt) {
-            return bool(compare_(elt, k));
-        });
-        auto vit = c_.values.begin() + (kit - c_.keys.begin());
-        return flatmap_detail::make_iterator(kit, vit);
+        auto idx = flat_detail::lower_bound_index(c_.keys, k, compare_);
+        return flatmap_detail::make_iterator(c_.keys.begin() + idx, c_.values.begin() + idx);
     }
 
     template<class K,
@@ -1054,6 +1059,97 @@ private:
         this->erase(it, end());
     }
 
+    // Appends each element, converted to value_type, to the containers.
+    template<class InputIterator>
+    void append_impl(InputIterator first, InputIterator last) {
+        size_t n = flat_detail::range_size_hint(first, last);
+        flat_detail::reserve_more_if_possible(c_.keys, n);
+        flat_detail::reserve_more_if_possible(c_.values, n);
+        for (; first != last; ++first) {
+            value_type v = *first;
+            c_.keys.insert(c_.keys.end(), v.first);
+            c_.values.insert(c_.values.end(), static_cast<Mapped&&>(v.second));
+        }
+    }
+
+    // Drops every element from position n on.
+    void truncate_impl(size_type n) noexcept {
+        c_.keys.erase(c_.keys.begin() + n, c_.keys.end());
+        c_.values.erase(c_.values.begin() + n, c_.values.end());
+    }
+
+    // The elements at [old_size, size()) have just been appended. "order" lists
+    // the offsets of the ones to keep, in increasing key order and with no two
+    // keys equivalent. Those whose keys are already in the map are dropped; the
+    // rest are merged into place from the back, so that each existing element
+    // is moved at most once. A throw before the merge drops only the new
+    // elements; a throw during it leaves the map empty.
+    template<class Order>
+    void merge_tail_impl(size_type old_size, const Order& order) {
+        auto kmid = c_.keys.begin() + old_size;
+        auto vmid = c_.values.begin() + old_size;
+        size_type tail_size = this->size() - old_size;
+
+        // The survivors are set aside in containers of the map's own types and allocators.
+        KeyContainer new_keys = flat_detail::make_empty_like(c_.keys);
+        MappedContainer new_values = flat_detail::make_empty_like(c_.values);
+        try {
+            // Fast path: the new elements are already in place.
+            if (order.size() == tail_size && (old_size == 0 || tail_size == 0 || compare_(*(kmid - 1), *kmid))) {
+                bool in_place = true;
+                for (size_type i = 0; i < tail_size && in_place; ++i) {
+                    in_place = (order[i] == i);
+                }
+                if (in_place) {
+                    return;
+                }
+            }
+
+            flat_detail::reserve_if_possible(new_keys, order.size());
+            flat_detail::reserve_if_possible(new_values, order.size());
+            auto kit = c_.keys.begin();
+            for (size_type i = 0; i < order.size(); ++i) {
+                auto&& k = *(kmid + order[i]);
+                kit = std::partition_point(kit, kmid, [&](const auto& elt) {
+                    return bool(compare_(elt, k));
+                });
+                if (kit == kmid || bool(compare_(k, *kit))) {
+                    new_keys.insert(new_keys.end(), std::move(k));
+                    new_values.insert(new_values.end(), std::move(*(vmid + order[i])));
+                }
+            }
+        } catch (...) {
+            this->truncate_impl(old_size);
+            throw;
+        }
+
+        size_type new_size = old_size + new_keys.size();
+        this->truncate_impl(new_size);
+
+        try {
+            size_type i = old_size;
+            size_type j = new_keys.size();
+            auto kout = c_.keys.begin() + new_size;
+            auto vout = c_.values.begin() + new_size;
+            while (j != 0) {
+                --kout;
+                --vout;
+                if (i != 0 && bool(compare_(*(new_keys.begin() + (j-1)), *(c_.keys.begin() + (i-1))))) {
+                    --i;
+                    *kout = std::move(*(c_.keys.begin() + i));
+                    *vout = std::move(*(c_.values.begin() + i));
+                } else {
+                    --j;
+                    *kout = std::move(*(new_keys.begin() + j));
+                    *vout = std::move(*(new_values.begin() + j));
+                }
+            }
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+    }
+
     containers c_;
     Compare compare_;
 };
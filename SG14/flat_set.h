@@ -36,6 +36,8 @@
 #include <iterator>
 #include <vector>
 
+#include "flat_detail.h"
+
 namespace stdext {
 
 namespace flatset_detail {
@@ -431,18 +433,16 @@ public:
 
     template<class InputIterator>
     void insert(sorted_unique_t, InputIterator first, InputIterator last) {
-        auto it = begin();
-        while (first != last) {
-            Key t(*first);
-            it = std::partition_point(it, end(), [&](const Key& elt) {
-                return bool(compare_(elt, t));
-            });
-            if (it == end() || compare_(t, *it)) {
-                it = c_.emplace(it, static_cast<Key&&>(t));
-            }
-            ++it;
-            ++first;
+        // The container grows once, and the merge fills it from the back.
+        // Until the merge starts, a throw only has to drop the new tail.
+        size_type old_size = this->size();
+        try {
+            c_.insert(c_.end(), first, last);
+        } catch (...) {
+            c_.erase(c_.begin() + old_size, c_.end());
+            throw;
         }
+        this->merge_tail_impl(old_size);
     }
 
     void insert(std::initializer_list<Key> il) {
@@ -558,15 +558,11 @@ public:
     }
 
     iterator lower_bound(const Key& t) {
-        return std::partition_point(this->begin(), this->end(), [&](const Key& elt) {
-            return bool(compare_(elt, t));
-        });
+        return this->begin() + flat_detail::lower_bound_index(c_, t, compare_);
     }
 
     const_iterator lower_bound(const Key& t) const {
-        return std::partition_point(this->begin(), this->end(), [&](const Key& elt) {
-            return bool(compare_(elt, t));
-        });
+        return this->begin() + flat_detail::lower_bound_index(c_, t, compare_);
     }
 
     template<class K,
@@ -664,6 +660,59 @@ private:
         c_.erase(it, c_.end());
     }
 
+    // The elements at [old_size, size()) have just been appended, and are
+    // sorted with no two equivalent. Those already in the set are dropped;
+    // the rest are set aside in a container of the set's own type and
+    // allocator, and merged into place from the back, so that each existing
+    // element is moved at most once. A throw before the merge drops only the
+    // new elements; a throw during it leaves the set empty.
+    void merge_tail_impl(size_type old_size) {
+        auto mid = c_.begin() + old_size;
+        KeyContainer new_keys = flat_detail::make_empty_like(c_);
+        try {
+            if (mid == c_.begin() || mid == c_.end() || compare_(*(mid - 1), *mid)) {
+                return;
+            }
+
+            flat_detail::reserve_if_possible(new_keys, this->size() - old_size);
+            auto it = c_.begin();
+            for (auto tail = mid; tail != c_.end(); ++tail) {
+                auto&& t = *tail;
+                it = std::partition_point(it, mid, [&](const Key& elt) {
+                    return bool(compare_(elt, t));
+                });
+                if (it == mid || bool(compare_(t, *it))) {
+                    new_keys.insert(new_keys.end(), std::move(t));
+                }
+            }
+        } catch (...) {
+            c_.erase(c_.begin() + old_size, c_.end());
+            throw;
+        }
+
+        size_type new_size = old_size + new_keys.size();
+        c_.erase(c_.begin() + new_size, c_.end());
+
+        try {
+            size_type i = old_size;
+            size_type j = new_keys.size();
+            auto out = c_.begin() + new_size;
+            while (j != 0) {
+                --out;
+                if (i != 0 && bool(compare_(*(new_keys.begin() + (j-1)), *(c_.begin() + (i-1))))) {
+                    --i;
+                    *out = std::move(*(c_.begin() + i));
+                } else {
+                    --j;
+                    *out = std::move(*(new_keys.begin() + j));
+                }
+            }
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+    }
+
     KeyContainer c_;
     Compare compare_;
 };
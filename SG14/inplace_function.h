@@ -26,9 +26,11 @@
 
 #pragma once
 
+#include <cstring>
 #include <type_traits>
 #include <utility>
 #include <functional>
+#include <memory>
 
 #ifndef SG14_INPLACE_FUNCTION_THROW
 #define SG14_INPLACE_FUNCTION_THROW(x) throw (x)
@@ -81,7 +83,9 @@ template<class T> struct wrapper
     using type = T;
 };
 
-template<class R, class... Args> struct vtable
+// The operations every stored callable needs. inplace_unique_function,
+// which never copies, uses this alone.
+template<class R, class... Args> struct unique_vtable
 {
     using storage_ptr_t = void*;
 
@@ -90,28 +94,34 @@ template<class R, class... Args> struct vtable
     using destructor_ptr_t = void(*)(storage_ptr_t);
 
     const invoke_ptr_t invoke_ptr;
-    const process_ptr_t copy_ptr;
     const process_ptr_t relocate_ptr;
     const destructor_ptr_t destructor_ptr;
 
-    explicit constexpr vtable() noexcept :
+    // Whether the callable can be copied and relocated with memcpy and
+    // needs no destructor call, so that the pointers above can be skipped.
+    const bool trivially_copyable;
+
+    // Whether this is the vtable of an empty function. Its storage is
+    // uninitialized, so it must not take the memcpy path; there is nothing
+    // to copy, relocate or destroy instead.
+    const bool is_empty;
+
+    explicit constexpr unique_vtable() noexcept :
         invoke_ptr{ [](storage_ptr_t, Args&&...) -> R
             { SG14_INPLACE_FUNCTION_THROW(std::bad_function_call()); }
         },
-        copy_ptr{ [](storage_ptr_t, storage_ptr_t) -> void {} },
         relocate_ptr{ [](storage_ptr_t, storage_ptr_t) -> void {} },
-        destructor_ptr{ [](storage_ptr_t) -> void {} }
+        destructor_ptr{ [](storage_ptr_t) -> void {} },
+        trivially_copyable{false},
+        is_empty{true}
     {}
 
-    template<class C> explicit constexpr vtable(wrapper<C>) noexcept :
+    template<class C> explicit constexpr unique_vtable(wrapper<C>) noexcept :
         invoke_ptr{ [](storage_ptr_t storage_ptr, Args&&... args) -> R
             { return (*static_cast<C*>(storage_ptr))(
                 static_cast<Args&&>(args)...
             ); }
         },
-        copy_ptr{ [](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void
-            { ::new (dst_ptr) C{ (*static_cast<C*>(src_ptr)) }; }
-        },
         relocate_ptr{ [](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void
             {
                 ::new (dst_ptr) C{ std::move(*static_cast<C*>(src_ptr)) };
@@ -120,16 +130,38 @@ template<class R, class... Args> struct vtable
         },
         destructor_ptr{ [](storage_ptr_t src_ptr) -> void
             { static_cast<C*>(src_ptr)->~C(); }
-        }
+        },
+        trivially_copyable{std::is_trivially_copyable<C>::value},
+        is_empty{false}
     {}
 
-    vtable(const vtable&) = delete;
-    vtable(vtable&&) = delete;
+    unique_vtable(const unique_vtable&) = delete;
+    unique_vtable(unique_vtable&&) = delete;
 
-    vtable& operator= (const vtable&) = delete;
-    vtable& operator= (vtable&&) = delete;
+    unique_vtable& operator= (const unique_vtable&) = delete;
+    unique_vtable& operator= (unique_vtable&&) = delete;
+
+    ~unique_vtable() = default;
+};
+
+template<class R, class... Args> struct vtable : unique_vtable<R, Args...>
+{
+    using typename unique_vtable<R, Args...>::storage_ptr_t;
+    using typename unique_vtable<R, Args...>::process_ptr_t;
+
+    const process_ptr_t copy_ptr;
+
+    explicit constexpr vtable() noexcept :
+        unique_vtable<R, Args...>(),
+        copy_ptr{ [](storage_ptr_t, storage_ptr_t) -> void {} }
+    {}
 
-    ~vtable() = default;
+    template<class C> explicit constexpr vtable(wrapper<C> w) noexcept :
+        unique_vtable<R, Args...>(w),
+        copy_ptr{ [](storage_ptr_t dst_ptr, storage_ptr_t src_ptr) -> void
+            { ::new (dst_ptr) C{ (*static_cast<C*>(src_ptr)) }; }
+        }
+    {}
 };
 
 template<class R, class... Args>
@@ -138,6 +170,55 @@ inline constexpr
 #endif
 vtable<R, Args...> empty_vtable{};
 
+template<class R, class... Args>
+#if __cplusplus >= 201703L
+inline constexpr
+#endif
+unique_vtable<R, Args...> empty_unique_vtable{};
+
+// Relocate, copy and destroy the callable described by vt, going through
+// its vtable only when it is not trivially copyable. Size is the number of
+// bytes of storage to copy.
+template<size_t Size, class R, class... Args>
+inline void relocate(const unique_vtable<R, Args...>* vt, void* dst_ptr, void* src_ptr) noexcept
+{
+    if (vt->trivially_copyable) {
+        std::memcpy(dst_ptr, src_ptr, Size);
+    } else if (!vt->is_empty) {
+        vt->relocate_ptr(dst_ptr, src_ptr);
+    }
+}
+
+template<size_t Size, class R, class... Args>
+inline void copy(const vtable<R, Args...>* vt, void* dst_ptr, void* src_ptr)
+{
+    if (vt->trivially_copyable) {
+        std::memcpy(dst_ptr, src_ptr, Size);
+    } else if (!vt->is_empty) {
+        vt->copy_ptr(dst_ptr, src_ptr);
+    }
+}
+
+// Zeroes the storage before an empty callable is constructed in it. Such a
+// callable initializes no bytes at all, yet relocate() and copy() memcpy
+// the whole storage for it, and a compiler that cannot see which branch
+// they take warns about the uninitialized read.
+template<class C>
+inline void prepare_storage(void* ptr, size_t size) noexcept
+{
+    if (std::is_empty<C>::value) {
+        std::memset(ptr, 0, size);
+    }
+}
+
+template<class R, class... Args>
+inline void destroy(const unique_vtable<R, Args...>* vt, void* ptr) noexcept
+{
+    if (!vt->trivially_copyable && !vt->is_empty) {
+        vt->destructor_ptr(ptr);
+    }
+}
+
 template<size_t DstCap, size_t DstAlign, size_t SrcCap, size_t SrcAlign>
 struct is_valid_inplace_dst : std::true_type
 {
@@ -188,37 +269,220 @@ template<class R, class F, class... Args> using is_invocable_r = is_invocable_r_
 template<
     class Signature,
     size_t Capacity = inplace_function_detail::InplaceFunctionDefaultCapacity,
-    size_t Alignment = alignof(inplace_function_detail::aligned_storage_t<Capacity>)
+    size_t Alignment = alignof(inplace_function_detail::aligned_storage_t<Capacity>),
+    bool InlineInvoker = false
 >
 class inplace_function; // unspecified
 
 namespace inplace_function_detail {
     template<class> struct is_inplace_function : std::false_type {};
-    template<class Sig, size_t Cap, size_t Align>
-    struct is_inplace_function<inplace_function<Sig, Cap, Align>> : std::true_type {};
+    template<class Sig, size_t Cap, size_t Align, bool Inline>
+    struct is_inplace_function<inplace_function<Sig, Cap, Align, Inline>> : std::true_type {};
+
+    // Where an inplace_function finds its invoker: in the vtable, or, with
+    // InlineInvoker, in a copy kept next to the vtable pointer. The copy
+    // costs a pointer per object and saves a dependent load per call.
+    template<bool Inline, class R, class... Args> struct invoker_cache
+    {
+        using invoke_ptr_t = typename unique_vtable<R, Args...>::invoke_ptr_t;
+
+        void set_invoker(const unique_vtable<R, Args...>*) noexcept {}
+        invoke_ptr_t invoker(const unique_vtable<R, Args...>* vt) const noexcept { return vt->invoke_ptr; }
+    };
+
+    template<class R, class... Args> struct invoker_cache<true, R, Args...>
+    {
+        using invoke_ptr_t = typename unique_vtable<R, Args...>::invoke_ptr_t;
+
+        void set_invoker(const unique_vtable<R, Args...>* vt) noexcept { invoke_ptr_ = vt->invoke_ptr; }
+        invoke_ptr_t invoker(const unique_vtable<R, Args...>*) const noexcept { return invoke_ptr_; }
+
+    private:
+        invoke_ptr_t invoke_ptr_;
+    };
+
+    // The vtable every empty function of a given kind points at.
+    template<class VTable> struct empty_vtable_of;
+
+    template<class R, class... Args> struct empty_vtable_of<vtable<R, Args...>>
+    {
+        static constexpr const vtable<R, Args...>* get() noexcept { return std::addressof(empty_vtable<R, Args...>); }
+    };
+
+    template<class R, class... Args> struct empty_vtable_of<unique_vtable<R, Args...>>
+    {
+        static constexpr const unique_vtable<R, Args...>* get() noexcept { return std::addressof(empty_unique_vtable<R, Args...>); }
+    };
+
+    // The vtable pointer and storage of inplace_function,
+    // inplace_unique_function and small_function, and what they do alike
+    // with them: tracking emptiness, copying, relocating, destroying and
+    // swapping the stored callable, and calling it. Derived is the function
+    // class itself, and VTable the kind of vtable it needs.
+    template<class Derived, class VTable, size_t Capacity, size_t Alignment, bool InlineInvoker, class R, class... Args>
+    class function_base : private invoker_cache<InlineInvoker, R, Args...>
+    {
+    protected:
+        using storage_t = aligned_storage_t<Capacity, Alignment>;
+        using vtable_t = VTable;
+        using vtable_ptr_t = const vtable_t*;
+
+        static constexpr vtable_ptr_t empty() noexcept { return empty_vtable_of<VTable>::get(); }
+
+        function_base() noexcept
+        {
+            set_vtable(empty());
+        }
+
+        // Only instantiated for vtables with a copy entry.
+        function_base(const function_base& other) :
+            invoker_cache<InlineInvoker, R, Args...>(other),
+            vtable_ptr_{other.vtable_ptr_}
+        {
+            inplace_function_detail::copy<sizeof(storage_t)>(
+                vtable_ptr_,
+                std::addressof(storage_),
+                std::addressof(other.storage_)
+            );
+        }
+
+        function_base(function_base&& other) noexcept :
+            invoker_cache<InlineInvoker, R, Args...>(other),
+            vtable_ptr_{other.vtable_ptr_}
+        {
+            other.set_vtable(empty());
+            inplace_function_detail::relocate<sizeof(storage_t)>(
+                vtable_ptr_,
+                std::addressof(storage_),
+                std::addressof(other.storage_)
+            );
+        }
+
+        function_base& operator= (const function_base&) = delete;
+
+        ~function_base()
+        {
+            inplace_function_detail::destroy(vtable_ptr_, std::addressof(storage_));
+        }
+
+        void reset() noexcept
+        {
+            inplace_function_detail::destroy(vtable_ptr_, std::addressof(storage_));
+            set_vtable(empty());
+        }
+
+        // Destroys the stored callable and relocates other's in its place.
+        void take(function_base& other) noexcept
+        {
+            if (this == std::addressof(other)) return;
+
+            inplace_function_detail::destroy(vtable_ptr_, std::addressof(storage_));
+
+            set_vtable(other.vtable_ptr_);
+            other.set_vtable(empty());
+            inplace_function_detail::relocate<sizeof(storage_t)>(
+                vtable_ptr_,
+                std::addressof(storage_),
+                std::addressof(other.storage_)
+            );
+        }
+
+        void set_vtable(vtable_ptr_t vtable_ptr) noexcept
+        {
+            vtable_ptr_ = vtable_ptr;
+            this->set_invoker(vtable_ptr);
+        }
+
+        R invoke(Args&&... args) const
+        {
+            return this->invoker(vtable_ptr_)(
+                std::addressof(storage_),
+                static_cast<Args&&>(args)...
+            );
+        }
+
+        vtable_ptr_t vtable_ptr_;
+        mutable storage_t storage_;
+
+    public:
+        constexpr bool operator== (std::nullptr_t) const noexcept
+        {
+            return !operator bool();
+        }
+
+        constexpr bool operator!= (std::nullptr_t) const noexcept
+        {
+            return operator bool();
+        }
+
+        explicit constexpr operator bool() const noexcept
+        {
+            return vtable_ptr_ != empty();
+        }
+
+        void swap(Derived& derived) noexcept
+        {
+            function_base& other = derived;
+            if (this == std::addressof(other)) return;
+
+            storage_t tmp;
+            inplace_function_detail::relocate<sizeof(storage_t)>(
+                vtable_ptr_,
+                std::addressof(tmp),
+                std::addressof(storage_)
+            );
+
+            inplace_function_detail::relocate<sizeof(storage_t)>(
+                other.vtable_ptr_,
+                std::addressof(storage_),
+                std::addressof(other.storage_)
+            );
+
+            inplace_function_detail::relocate<sizeof(storage_t)>(
+                vtable_ptr_,
+                std::addressof(other.storage_),
+                std::addressof(tmp)
+            );
+
+            vtable_ptr_t tmp_vtable_ptr = vtable_ptr_;
+            set_vtable(other.vtable_ptr_);
+            other.set_vtable(tmp_vtable_ptr);
+        }
+
+        friend void swap(Derived& lhs, Derived& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    };
 } // namespace inplace_function_detail
 
 template<
     class R,
     class... Args,
     size_t Capacity,
-    size_t Alignment
+    size_t Alignment,
+    bool InlineInvoker
 >
-class inplace_function<R(Args...), Capacity, Alignment>
+class inplace_function<R(Args...), Capacity, Alignment, InlineInvoker>
+    : public inplace_function_detail::function_base<
+        inplace_function<R(Args...), Capacity, Alignment, InlineInvoker>,
+        inplace_function_detail::vtable<R, Args...>, Capacity, Alignment, InlineInvoker, R, Args...
+    >
 {
-    using storage_t = inplace_function_detail::aligned_storage_t<Capacity, Alignment>;
-    using vtable_t = inplace_function_detail::vtable<R, Args...>;
-    using vtable_ptr_t = const vtable_t*;
+    using base_t = inplace_function_detail::function_base<
+        inplace_function, inplace_function_detail::vtable<R, Args...>, Capacity, Alignment, InlineInvoker, R, Args...
+    >;
+    using typename base_t::storage_t;
+    using typename base_t::vtable_t;
+    using typename base_t::vtable_ptr_t;
 
-    template <class, size_t, size_t> friend class inplace_function;
+    template <class, size_t, size_t, bool> friend class inplace_function;
 
 public:
     using capacity = std::integral_constant<size_t, Capacity>;
     using alignment = std::integral_constant<size_t, Alignment>;
 
-    inplace_function() noexcept :
-        vtable_ptr_{std::addressof(inplace_function_detail::empty_vtable<R, Args...>)}
-    {}
+    inplace_function() noexcept = default;
 
     template<
         class T,
@@ -243,139 +507,409 @@ public:
         );
 
         static const vtable_t vt{inplace_function_detail::wrapper<C>{}};
-        vtable_ptr_ = std::addressof(vt);
 
-        ::new (std::addressof(storage_)) C{std::forward<T>(closure)};
+        inplace_function_detail::prepare_storage<C>(std::addressof(this->storage_), sizeof(storage_t));
+        ::new (std::addressof(this->storage_)) C{std::forward<T>(closure)};
+        this->set_vtable(std::addressof(vt));
     }
 
-    template<size_t Cap, size_t Align>
-    inplace_function(const inplace_function<R(Args...), Cap, Align>& other)
-        : inplace_function(other.vtable_ptr_, other.vtable_ptr_->copy_ptr, std::addressof(other.storage_))
+    template<size_t Cap, size_t Align, bool Inline>
+    inplace_function(const inplace_function<R(Args...), Cap, Align, Inline>& other)
+        : inplace_function(other.vtable_ptr_, other.vtable_ptr_->copy_ptr, std::addressof(other.storage_), Cap)
     {
         static_assert(inplace_function_detail::is_valid_inplace_dst<
             Capacity, Alignment, Cap, Align
         >::value, "conversion not allowed");
     }
 
-    template<size_t Cap, size_t Align>
-    inplace_function(inplace_function<R(Args...), Cap, Align>&& other) noexcept
-        : inplace_function(other.vtable_ptr_, other.vtable_ptr_->relocate_ptr, std::addressof(other.storage_))
+    template<size_t Cap, size_t Align, bool Inline>
+    inplace_function(inplace_function<R(Args...), Cap, Align, Inline>&& other) noexcept
+        : inplace_function(other.vtable_ptr_, other.vtable_ptr_->relocate_ptr, std::addressof(other.storage_), Cap)
     {
         static_assert(inplace_function_detail::is_valid_inplace_dst<
             Capacity, Alignment, Cap, Align
         >::value, "conversion not allowed");
 
-        other.vtable_ptr_ = std::addressof(inplace_function_detail::empty_vtable<R, Args...>);
+        other.set_vtable(base_t::empty());
     }
 
     inplace_function(std::nullptr_t) noexcept :
-        vtable_ptr_{std::addressof(inplace_function_detail::empty_vtable<R, Args...>)}
+        inplace_function()
     {}
 
-    inplace_function(const inplace_function& other) :
-        vtable_ptr_{other.vtable_ptr_}
+    inplace_function(const inplace_function&) = default;
+    inplace_function(inplace_function&&) noexcept = default;
+
+    inplace_function& operator= (std::nullptr_t) noexcept
     {
-        vtable_ptr_->copy_ptr(
-            std::addressof(storage_),
-            std::addressof(other.storage_)
-        );
+        this->reset();
+        return *this;
     }
 
-    inplace_function(inplace_function&& other) noexcept :
-        vtable_ptr_{std::exchange(other.vtable_ptr_, std::addressof(inplace_function_detail::empty_vtable<R, Args...>))}
+    inplace_function& operator= (inplace_function other) noexcept
     {
-        vtable_ptr_->relocate_ptr(
-            std::addressof(storage_),
-            std::addressof(other.storage_)
-        );
+        this->take(other);
+        return *this;
     }
 
-    inplace_function& operator= (std::nullptr_t) noexcept
+    R operator() (Args... args) const
     {
-        vtable_ptr_->destructor_ptr(std::addressof(storage_));
-        vtable_ptr_ = std::addressof(inplace_function_detail::empty_vtable<R, Args...>);
-        return *this;
+        return this->invoke(std::forward<Args>(args)...);
     }
 
-    inplace_function& operator= (inplace_function other) noexcept
+private:
+    inplace_function(
+        vtable_ptr_t vtable_ptr,
+        typename vtable_t::process_ptr_t process_ptr,
+        typename vtable_t::storage_ptr_t storage_ptr,
+        size_t storage_size
+    )
+    {
+        if (vtable_ptr->trivially_copyable) {
+            std::memcpy(std::addressof(this->storage_), storage_ptr, storage_size);
+        } else {
+            process_ptr(std::addressof(this->storage_), storage_ptr);
+        }
+        this->set_vtable(vtable_ptr);
+    }
+};
+
+template<
+    class Signature,
+    size_t Capacity = inplace_function_detail::InplaceFunctionDefaultCapacity,
+    size_t Alignment = alignof(inplace_function_detail::aligned_storage_t<Capacity>)
+>
+class inplace_unique_function; // unspecified
+
+namespace inplace_function_detail {
+    template<class> struct is_inplace_unique_function : std::false_type {};
+    template<class Sig, size_t Cap, size_t Align>
+    struct is_inplace_unique_function<inplace_unique_function<Sig, Cap, Align>> : std::true_type {};
+} // namespace inplace_function_detail
+
+// A move-only inplace_function. It accepts callables that cannot be copied,
+// such as lambdas capturing a unique_ptr or a promise, and its vtable has no
+// copy entry.
+template<
+    class R,
+    class... Args,
+    size_t Capacity,
+    size_t Alignment
+>
+class inplace_unique_function<R(Args...), Capacity, Alignment>
+    : public inplace_function_detail::function_base<
+        inplace_unique_function<R(Args...), Capacity, Alignment>,
+        inplace_function_detail::unique_vtable<R, Args...>, Capacity, Alignment, false, R, Args...
+    >
+{
+    using base_t = inplace_function_detail::function_base<
+        inplace_unique_function, inplace_function_detail::unique_vtable<R, Args...>, Capacity, Alignment, false, R, Args...
+    >;
+    using typename base_t::storage_t;
+    using typename base_t::vtable_t;
+
+    template <class, size_t, size_t> friend class inplace_unique_function;
+
+public:
+    using capacity = std::integral_constant<size_t, Capacity>;
+    using alignment = std::integral_constant<size_t, Alignment>;
+
+    inplace_unique_function() noexcept = default;
+
+    template<
+        class T,
+        class C = std::decay_t<T>,
+        class = std::enable_if_t<
+            !inplace_function_detail::is_inplace_unique_function<C>::value
+            && inplace_function_detail::is_invocable_r<R, C&, Args...>::value
+        >
+    >
+    inplace_unique_function(T&& closure)
+    {
+        static_assert(std::is_move_constructible<C>::value,
+            "inplace_unique_function cannot be constructed from non-movable type"
+        );
+
+        static_assert(sizeof(C) <= Capacity,
+            "inplace_unique_function cannot be constructed from object with this (large) size"
+        );
+
+        static_assert(Alignment % alignof(C) == 0,
+            "inplace_unique_function cannot be constructed from object with this (large) alignment"
+        );
+
+        static const vtable_t vt{inplace_function_detail::wrapper<C>{}};
+
+        inplace_function_detail::prepare_storage<C>(std::addressof(this->storage_), sizeof(storage_t));
+        ::new (std::addressof(this->storage_)) C{std::forward<T>(closure)};
+        this->set_vtable(std::addressof(vt));
+    }
+
+    template<size_t Cap, size_t Align>
+    inplace_unique_function(inplace_unique_function<R(Args...), Cap, Align>&& other) noexcept
     {
-        vtable_ptr_->destructor_ptr(std::addressof(storage_));
+        static_assert(inplace_function_detail::is_valid_inplace_dst<
+            Capacity, Alignment, Cap, Align
+        >::value, "conversion not allowed");
 
-        vtable_ptr_ = std::exchange(other.vtable_ptr_, std::addressof(inplace_function_detail::empty_vtable<R, Args...>));
-        vtable_ptr_->relocate_ptr(
-            std::addressof(storage_),
+        inplace_function_detail::relocate<Cap>(
+            other.vtable_ptr_,
+            std::addressof(this->storage_),
             std::addressof(other.storage_)
         );
+        this->set_vtable(other.vtable_ptr_);
+        other.set_vtable(base_t::empty());
+    }
+
+    inplace_unique_function(std::nullptr_t) noexcept :
+        inplace_unique_function()
+    {}
+
+    inplace_unique_function(const inplace_unique_function&) = delete;
+    inplace_unique_function(inplace_unique_function&&) noexcept = default;
+
+    inplace_unique_function& operator= (std::nullptr_t) noexcept
+    {
+        this->reset();
         return *this;
     }
 
-    ~inplace_function()
+    inplace_unique_function& operator= (const inplace_unique_function&) = delete;
+
+    inplace_unique_function& operator= (inplace_unique_function&& other) noexcept
     {
-        vtable_ptr_->destructor_ptr(std::addressof(storage_));
+        this->take(other);
+        return *this;
     }
 
     R operator() (Args... args) const
     {
-        return vtable_ptr_->invoke_ptr(
-            std::addressof(storage_),
-            std::forward<Args>(args)...
-        );
+        return this->invoke(std::forward<Args>(args)...);
     }
+};
+
+template<
+    class Signature,
+    size_t Capacity = inplace_function_detail::InplaceFunctionDefaultCapacity,
+    class Allocator = std::allocator<char>,
+    size_t Alignment = alignof(inplace_function_detail::aligned_storage_t<Capacity>)
+>
+class small_function; // unspecified
+
+namespace inplace_function_detail {
+
+// The vtable of a small_function also records whether the callable it
+// describes lives on the heap.
+template<class R, class... Args> struct spill_vtable : vtable<R, Args...>
+{
+    const bool spilled;
+
+    explicit constexpr spill_vtable() noexcept :
+        vtable<R, Args...>(), spilled{false}
+    {}
+
+    template<class C> explicit constexpr spill_vtable(wrapper<C> w, bool s) noexcept :
+        vtable<R, Args...>(w), spilled{s}
+    {}
+};
+
+template<class R, class... Args>
+#if __cplusplus >= 201703L
+inline constexpr
+#endif
+spill_vtable<R, Args...> empty_spill_vtable{};
+
+template<class R, class... Args> struct empty_vtable_of<spill_vtable<R, Args...>>
+{
+    static constexpr const spill_vtable<R, Args...>* get() noexcept { return std::addressof(empty_spill_vtable<R, Args...>); }
+};
 
-    constexpr bool operator== (std::nullptr_t) const noexcept
+// Owns a C allocated from Alloc. This is what a small_function stores in
+// place of a callable too large for its buffer; moving it just moves the
+// pointer.
+template<class C, class Alloc>
+class heap_box : private std::allocator_traits<Alloc>::template rebind_alloc<C>
+{
+    using alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<C>;
+    using traits = std::allocator_traits<alloc_t>;
+
+public:
+    template<class T>
+    heap_box(const Alloc& alloc, T&& closure) :
+        alloc_t(alloc), ptr_{make(std::forward<T>(closure))}
+    {}
+
+    heap_box(const heap_box& other) :
+        alloc_t(traits::select_on_container_copy_construction(other.allocator())),
+        ptr_{make(*other.ptr_)}
+    {}
+
+    heap_box(heap_box&& other) noexcept :
+        alloc_t(std::move(other.allocator())), ptr_{std::exchange(other.ptr_, nullptr)}
+    {}
+
+    heap_box& operator= (const heap_box&) = delete;
+    heap_box& operator= (heap_box&&) = delete;
+
+    ~heap_box()
     {
-        return !operator bool();
+        if (ptr_ != nullptr) {
+            traits::destroy(allocator(), std::addressof(*ptr_));
+            traits::deallocate(allocator(), ptr_, 1);
+        }
     }
 
-    constexpr bool operator!= (std::nullptr_t) const noexcept
+    template<class... A>
+    decltype(auto) operator() (A&&... args)
     {
-        return operator bool();
+        return (*ptr_)(std::forward<A>(args)...);
     }
 
-    explicit constexpr operator bool() const noexcept
+private:
+    alloc_t& allocator() noexcept { return *this; }
+    const alloc_t& allocator() const noexcept { return *this; }
+
+    template<class T>
+    typename traits::pointer make(T&& closure)
     {
-        return vtable_ptr_ != std::addressof(inplace_function_detail::empty_vtable<R, Args...>);
+        auto p = traits::allocate(allocator(), 1);
+        try {
+            traits::construct(allocator(), std::addressof(*p), std::forward<T>(closure));
+        } catch (...) {
+            traits::deallocate(allocator(), p, 1);
+            throw;
+        }
+        return p;
     }
 
-    void swap(inplace_function& other) noexcept
-    {
-        if (this == std::addressof(other)) return;
+    typename traits::pointer ptr_;
+};
 
-        storage_t tmp;
-        vtable_ptr_->relocate_ptr(
-            std::addressof(tmp),
-            std::addressof(storage_)
-        );
+template<class> struct is_small_function : std::false_type {};
+template<class Sig, size_t Cap, class Alloc, size_t Align>
+struct is_small_function<small_function<Sig, Cap, Alloc, Align>> : std::true_type {};
 
-        other.vtable_ptr_->relocate_ptr(
-            std::addressof(storage_),
-            std::addressof(other.storage_)
-        );
+} // namespace inplace_function_detail
+
+// Like inplace_function, but a callable that does not fit the buffer (or
+// whose alignment or throwing move constructor rules it out) is allocated
+// from Allocator instead of being rejected at compile time. spilled() says
+// which happened.
+template<
+    class R,
+    class... Args,
+    size_t Capacity,
+    class Allocator,
+    size_t Alignment
+>
+class small_function<R(Args...), Capacity, Allocator, Alignment>
+    : public inplace_function_detail::function_base<
+        small_function<R(Args...), Capacity, Allocator, Alignment>,
+        inplace_function_detail::spill_vtable<R, Args...>, Capacity, Alignment, false, R, Args...
+    >
+{
+    using base_t = inplace_function_detail::function_base<
+        small_function, inplace_function_detail::spill_vtable<R, Args...>, Capacity, Alignment, false, R, Args...
+    >;
+    using typename base_t::storage_t;
+    using typename base_t::vtable_t;
+
+    template<class C>
+    using fits_inplace = std::integral_constant<bool,
+        sizeof(C) <= Capacity
+        && Alignment % alignof(C) == 0
+        && std::is_nothrow_move_constructible<C>::value
+    >;
+
+public:
+    using capacity = std::integral_constant<size_t, Capacity>;
+    using alignment = std::integral_constant<size_t, Alignment>;
+    using allocator_type = Allocator;
+
+    small_function() noexcept = default;
 
-        vtable_ptr_->relocate_ptr(
-            std::addressof(other.storage_),
-            std::addressof(tmp)
+    small_function(std::nullptr_t) noexcept :
+        small_function()
+    {}
+
+    template<
+        class T,
+        class C = std::decay_t<T>,
+        class = std::enable_if_t<
+            !inplace_function_detail::is_small_function<C>::value
+            && inplace_function_detail::is_invocable_r<R, C&, Args...>::value
+        >
+    >
+    small_function(T&& closure) :
+        small_function(std::allocator_arg, Allocator(), std::forward<T>(closure))
+    {}
+
+    template<
+        class T,
+        class C = std::decay_t<T>,
+        class = std::enable_if_t<
+            !inplace_function_detail::is_small_function<C>::value
+            && inplace_function_detail::is_invocable_r<R, C&, Args...>::value
+        >
+    >
+    small_function(std::allocator_arg_t, const Allocator& alloc, T&& closure)
+    {
+        static_assert(std::is_copy_constructible<C>::value,
+            "small_function cannot be constructed from non-copyable type"
         );
 
-        std::swap(vtable_ptr_, other.vtable_ptr_);
+        emplace<C>(fits_inplace<C>{}, alloc, std::forward<T>(closure));
     }
 
-    friend void swap(inplace_function& lhs, inplace_function& rhs) noexcept
+    small_function(const small_function&) = default;
+    small_function(small_function&&) noexcept = default;
+
+    small_function& operator= (std::nullptr_t) noexcept
     {
-        lhs.swap(rhs);
+        this->reset();
+        return *this;
+    }
+
+    small_function& operator= (small_function other) noexcept
+    {
+        this->take(other);
+        return *this;
+    }
+
+    R operator() (Args... args) const
+    {
+        return this->invoke(std::forward<Args>(args)...);
+    }
+
+    // True if the stored callable did not fit in place and was allocated
+    // from the allocator.
+    bool spilled() const noexcept
+    {
+        return this->vtable_ptr_->spilled;
     }
 
 private:
-    vtable_ptr_t vtable_ptr_;
-    mutable storage_t storage_;
+    template<class C, class T>
+    void emplace(std::true_type, const Allocator&, T&& closure)
+    {
+        static const vtable_t vt{inplace_function_detail::wrapper<C>{}, false};
+        inplace_function_detail::prepare_storage<C>(std::addressof(this->storage_), sizeof(storage_t));
+        ::new (std::addressof(this->storage_)) C{std::forward<T>(closure)};
+        this->set_vtable(std::addressof(vt));
+    }
 
-    inplace_function(
-        vtable_ptr_t vtable_ptr,
-        typename vtable_t::process_ptr_t process_ptr,
-        typename vtable_t::storage_ptr_t storage_ptr
-    ) : vtable_ptr_{vtable_ptr}
+    template<class C, class T>
+    void emplace(std::false_type, const Allocator& alloc, T&& closure)
     {
-        process_ptr(std::addressof(storage_), storage_ptr);
+        using box_t = inplace_function_detail::heap_box<C, Allocator>;
+
+        static_assert(fits_inplace<box_t>::value,
+            "small_function capacity is too small to hold even a pointer to a spilled callable"
+        );
+
+        static const vtable_t vt{inplace_function_detail::wrapper<box_t>{}, true};
+        ::new (std::addressof(this->storage_)) box_t{alloc, std::forward<T>(closure)};
+        this->set_vtable(std::addressof(vt));
     }
 };
 
@@ -0,0 +1,226 @@
+#pragma once
+
+// Storage for ring_span whose pages are mapped twice, back to back, so that
+// element i and element i + capacity() are the same object. A ring_span
+// built over [begin(), end()) can then be read or written as one contiguous
+// range of up to capacity() elements starting at any of its slots, e.g.
+// [&r.front(), &r.front() + r.size()), with no split at the wrap point.
+//
+// Linux only: the mapping is made with memfd_create and mmap. Where the C
+// library does not wrap memfd_create (glibc before 2.27) the system call is
+// made directly; SG14_HAS_MIRRORED_BUFFER is defined when either is usable.
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(MFD_CLOEXEC) || defined(SYS_memfd_create)
+#define SG14_HAS_MIRRORED_BUFFER 1
+#endif
+#endif
+
+#if defined(SG14_HAS_MIRRORED_BUFFER)
+
+#include <cerrno>
+#include <cstddef>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace sg14
+{
+	template <typename T>
+	class mirrored_buffer
+	{
+		static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value,
+			"mirrored_buffer aliases every element, so T must be trivial");
+
+	public:
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		// The capacity is rounded up to a whole number of pages. Throws
+		// std::system_error if the mapping cannot be made, or if twice the
+		// rounded size would not fit in a size_type.
+		explicit mirrored_buffer(size_type min_capacity);
+
+		mirrored_buffer(mirrored_buffer&& rhs) noexcept;
+		mirrored_buffer& operator=(mirrored_buffer&& rhs) noexcept;
+		~mirrored_buffer();
+
+		size_type capacity() const noexcept;
+
+		// The first mapping. data()[capacity()] through
+		// data()[2 * capacity() - 1] are the mirror.
+		T* data() noexcept;
+		const T* data() const noexcept;
+
+		iterator begin() noexcept;
+		const_iterator begin() const noexcept;
+		iterator end() noexcept;
+		const_iterator end() const noexcept;
+
+		// Example implementation
+	private:
+		static int create_memfd() noexcept;
+		void release() noexcept;
+
+		T* m_data;
+		size_type m_capacity;
+	};
+} // namespace sg14
+
+// Sample implementation
+
+template <typename T>
+sg14::mirrored_buffer<T>::mirrored_buffer(size_type min_capacity)
+	: m_data(nullptr)
+	, m_capacity(0)
+{
+	const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+	if (page % sizeof(T) != 0)
+	{
+		throw std::system_error(std::make_error_code(std::errc::invalid_argument), "mirrored_buffer: sizeof(T) must divide the page size");
+	}
+	// Both halves are mapped, so 2 * bytes must not wrap either.
+	if (min_capacity > (std::numeric_limits<size_type>::max() / 2 - page) / sizeof(T))
+	{
+		throw std::system_error(std::make_error_code(std::errc::not_enough_memory), "mirrored_buffer: capacity too large");
+	}
+	size_type bytes = (min_capacity * sizeof(T) + page - 1) / page * page;
+	if (bytes == 0)
+	{
+		bytes = page;
+	}
+
+	int fd = create_memfd();
+	if (fd == -1)
+	{
+		throw std::system_error(errno, std::system_category(), "memfd_create");
+	}
+	if (::ftruncate(fd, static_cast<off_t>(bytes)) == -1)
+	{
+		int error = errno;
+		::close(fd);
+		throw std::system_error(error, std::system_category(), "ftruncate");
+	}
+
+	// Reserve both halves first, so that nothing else can be mapped into
+	// the second half between the two fixed mappings.
+	void* base = ::mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+	{
+		int error = errno;
+		::close(fd);
+		throw std::system_error(error, std::system_category(), "mmap");
+	}
+	char* first = static_cast<char*>(base);
+	if (::mmap(first, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+		|| ::mmap(first + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+	{
+		int error = errno;
+		::munmap(base, 2 * bytes);
+		::close(fd);
+		throw std::system_error(error, std::system_category(), "mmap");
+	}
+	// The mappings keep the memory alive.
+	::close(fd);
+
+	m_data = reinterpret_cast<T*>(first);
+	m_capacity = bytes / sizeof(T);
+}
+
+template <typename T>
+sg14::mirrored_buffer<T>::mirrored_buffer(mirrored_buffer&& rhs) noexcept
+	: m_data(std::exchange(rhs.m_data, nullptr))
+	, m_capacity(std::exchange(rhs.m_capacity, 0))
+{}
+
+template <typename T>
+sg14::mirrored_buffer<T>& sg14::mirrored_buffer<T>::operator=(mirrored_buffer&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		release();
+		m_data = std::exchange(rhs.m_data, nullptr);
+		m_capacity = std::exchange(rhs.m_capacity, 0);
+	}
+	return *this;
+}
+
+template <typename T>
+sg14::mirrored_buffer<T>::~mirrored_buffer()
+{
+	release();
+}
+
+template <typename T>
+typename sg14::mirrored_buffer<T>::size_type sg14::mirrored_buffer<T>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template <typename T>
+T* sg14::mirrored_buffer<T>::data() noexcept
+{
+	return m_data;
+}
+
+template <typename T>
+const T* sg14::mirrored_buffer<T>::data() const noexcept
+{
+	return m_data;
+}
+
+template <typename T>
+typename sg14::mirrored_buffer<T>::iterator sg14::mirrored_buffer<T>::begin() noexcept
+{
+	return m_data;
+}
+
+template <typename T>
+typename sg14::mirrored_buffer<T>::const_iterator sg14::mirrored_buffer<T>::begin() const noexcept
+{
+	return m_data;
+}
+
+template <typename T>
+typename sg14::mirrored_buffer<T>::iterator sg14::mirrored_buffer<T>::end() noexcept
+{
+	return m_data + m_capacity;
+}
+
+template <typename T>
+typename sg14::mirrored_buffer<T>::const_iterator sg14::mirrored_buffer<T>::end() const noexcept
+{
+	return m_data + m_capacity;
+}
+
+template <typename T>
+int sg14::mirrored_buffer<T>::create_memfd() noexcept
+{
+#if defined(MFD_CLOEXEC)
+	return ::memfd_create("sg14::mirrored_buffer", MFD_CLOEXEC);
+#else
+	// MFD_CLOEXEC from <linux/memfd.h>.
+	return static_cast<int>(::syscall(SYS_memfd_create, "sg14::mirrored_buffer", 0x0001U));
+#endif
+}
+
+template <typename T>
+void sg14::mirrored_buffer<T>::release() noexcept
+{
+	if (m_data != nullptr)
+	{
+		::munmap(m_data, 2 * m_capacity * sizeof(T));
+		m_data = nullptr;
+		m_capacity = 0;
+	}
+}
+
+#endif // SG14_HAS_MIRRORED_BUFFER
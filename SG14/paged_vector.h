@@ -0,0 +1,285 @@
+/*
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+// paged_vector is a sequence container for slot_map (and slot_map_soa) that
+// never relocates its elements. It stores them in fixed-size pages whose
+// length is a power of two, reached through a table of page pointers, so
+// growing it allocates one more page instead of moving every element, and
+// references and pointers to elements stay valid until the element itself
+// is popped. Iterators are invalidated by emplace_back, as for std::vector.
+//
+// Pages are kept when elements are popped or cleared, so a container that
+// oscillates around a page boundary does not allocate; reserve(n) commits
+// pages up front, and shrink_to_fit() releases the unused ones.
+//
+//     stdext::slot_map<T, Key, stdext::paged_vector> sm;
+//     sm.reserve_slots(n);  // commits the pages for n slots
+//
+// basic_paged_vector<T, PageBytes> sizes each page to the largest power of
+// two elements fitting in PageBytes (but at least one element).
+
+#include <stddef.h>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdext {
+
+namespace paged_vector_detail {
+    constexpr size_t floor_log2(size_t n) {
+        size_t result = 0;
+        while (n > 1) {
+            n >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    // Element i lives at pages[i >> Shift][i & mask]. The iterator holds the
+    // page table and an index, so it stays cheap to copy and to advance by
+    // any distance.
+    template<class T, size_t Shift>
+    class iterator {
+        template<class, size_t> friend class iterator;
+        static constexpr ptrdiff_t mask = (ptrdiff_t(1) << Shift) - 1;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_const<T>::type;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(T *const *pages, ptrdiff_t index) noexcept : pages_(pages), index_(index) {}
+        template<class U, class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+        iterator(const iterator<U, Shift>& rhs) noexcept : pages_(rhs.pages_), index_(rhs.index_) {}
+
+        reference operator*() const noexcept { return pages_[index_ >> Shift][index_ & mask]; }
+        pointer operator->() const noexcept { return &**this; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        iterator& operator++() noexcept { ++index_; return *this; }
+        iterator operator++(int) noexcept { auto result = *this; ++index_; return result; }
+        iterator& operator--() noexcept { --index_; return *this; }
+        iterator operator--(int) noexcept { auto result = *this; --index_; return result; }
+        iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+        iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+        friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b) noexcept { return a.index_ - b.index_; }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.index_ == b.index_; }
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept { return a.index_ != b.index_; }
+        friend bool operator<(const iterator& a, const iterator& b) noexcept { return a.index_ < b.index_; }
+        friend bool operator>(const iterator& a, const iterator& b) noexcept { return a.index_ > b.index_; }
+        friend bool operator<=(const iterator& a, const iterator& b) noexcept { return a.index_ <= b.index_; }
+        friend bool operator>=(const iterator& a, const iterator& b) noexcept { return a.index_ >= b.index_; }
+
+    private:
+        T *const *pages_ = nullptr;
+        ptrdiff_t index_ = 0;
+    };
+} // namespace paged_vector_detail
+
+template<class T, size_t PageBytes = 4096>
+class basic_paged_vector {
+    static constexpr size_t page_shift = paged_vector_detail::floor_log2(PageBytes / sizeof(T));
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = paged_vector_detail::iterator<T, page_shift>;
+    using const_iterator = paged_vector_detail::iterator<const T, page_shift>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // The number of elements in each page.
+    static constexpr size_type page_size = size_type(1) << page_shift;
+
+    basic_paged_vector() noexcept = default;
+
+    // The copy starts out empty, so the destructor cleans up if an element
+    // copy throws partway.
+    basic_paged_vector(const basic_paged_vector& rhs) : basic_paged_vector() {
+        reserve(rhs.size_);
+        for (const T& value : rhs) {
+            emplace_back(value);
+        }
+    }
+    basic_paged_vector(basic_paged_vector&& rhs) noexcept
+        : pages_(std::move(rhs.pages_)), size_(std::exchange(rhs.size_, 0)) {}
+
+    basic_paged_vector& operator=(const basic_paged_vector& rhs) {
+        if (this != &rhs) {
+            basic_paged_vector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+    basic_paged_vector& operator=(basic_paged_vector&& rhs) noexcept {
+        basic_paged_vector moved(std::move(rhs));
+        swap(moved);
+        return *this;
+    }
+
+    ~basic_paged_vector() {
+        clear();
+        release_pages_from(0);
+    }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_type capacity() const noexcept { return pages_.size() * page_size; }
+
+    // Commits pages until capacity() >= n. Existing elements do not move.
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            pages_.reserve((n + page_size - 1) >> page_shift);
+            while (capacity() < n) {
+                add_page();
+            }
+        }
+    }
+
+    // Releases every page past the one holding the last element.
+    void shrink_to_fit() {
+        release_pages_from((size_ + page_size - 1) >> page_shift);
+        pages_.shrink_to_fit();
+    }
+
+    reference operator[](size_type i) noexcept { return *element(i); }
+    const_reference operator[](size_type i) const noexcept { return *element(i); }
+    reference at(size_type i) {
+        if (i >= size_) {
+            throw std::out_of_range("paged_vector::at");
+        }
+        return *element(i);
+    }
+    const_reference at(size_type i) const {
+        if (i >= size_) {
+            throw std::out_of_range("paged_vector::at");
+        }
+        return *element(i);
+    }
+    reference front() noexcept { return *element(0); }
+    const_reference front() const noexcept { return *element(0); }
+    reference back() noexcept { return *element(size_ - 1); }
+    const_reference back() const noexcept { return *element(size_ - 1); }
+
+    iterator begin() noexcept { return iterator(pages_.data(), 0); }
+    iterator end() noexcept { return iterator(pages_.data(), static_cast<difference_type>(size_)); }
+    const_iterator begin() const noexcept { return const_iterator(pages_.data(), 0); }
+    const_iterator end() const noexcept { return const_iterator(pages_.data(), static_cast<difference_type>(size_)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Allocates a page only when the last committed page is full. If the
+    // constructor throws, the container is unchanged apart from capacity().
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            add_page();
+        }
+        T *p = element(size_);
+        ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        element(size_)->~T();
+    }
+
+    // Destroys every element, but keeps the pages.
+    void clear() noexcept {
+        while (size_ != 0) {
+            pop_back();
+        }
+    }
+
+    // O(1): only the page tables are exchanged.
+    void swap(basic_paged_vector& rhs) noexcept {
+        using std::swap;
+        swap(pages_, rhs.pages_);
+        swap(size_, rhs.size_);
+    }
+    friend void swap(basic_paged_vector& a, basic_paged_vector& b) noexcept {
+        a.swap(b);
+    }
+
+private:
+    T *element(size_type i) const noexcept {
+        return pages_[i >> page_shift] + (i & (page_size - 1));
+    }
+
+    // The table grows geometrically before the page is allocated, so that
+    // the push_back cannot throw and leak it.
+    void add_page() {
+        if (pages_.size() == pages_.capacity()) {
+            pages_.reserve((std::max)(2 * pages_.size(), size_type(1)));
+        }
+        pages_.push_back(std::allocator<T>().allocate(page_size));
+    }
+
+    void release_pages_from(size_type first_page) noexcept {
+        while (pages_.size() > first_page) {
+            std::allocator<T>().deallocate(pages_.back(), page_size);
+            pages_.pop_back();
+        }
+    }
+
+    std::vector<T*> pages_;
+    size_type size_ = 0;
+};
+
+// paged_vector fits slot_map's Container template parameter; for another
+// page size, pass an alias of basic_paged_vector instead.
+template<class T>
+using paged_vector = basic_paged_vector<T>;
+
+} // namespace stdext
@@ -239,6 +239,12 @@
 	#include <concepts>
 #endif
 
+// Define PLF_COLONY_PARALLEL_SORT before including this header to enable sort(execution_policy, compare). Depending on the standard library, using a parallel policy may require linking a backend (eg. TBB for libstdc++):
+#if defined(PLF_COLONY_PARALLEL_SORT) && __cplusplus >= 201703L
+	#include <execution> // std::is_execution_policy, std::sort(policy, ...)
+	#define PLF_EXECUTION_POLICY_SUPPORT
+#endif
+
 
 namespace plf
 {
@@ -312,6 +318,10 @@ public:
 	friend class colony_reverse_iterator<false>;
 	friend class colony_reverse_iterator<true>;
 
+	template <bool g_is_const> class		colony_group_view;
+	typedef colony_group_view<false>		group_view;
+	typedef colony_group_view<true>		const_group_view;
+
 
 
 private:
@@ -1633,6 +1643,37 @@ public:
 
 
 
+	// Group views - the active elements of a single memory block, as passed to for_each_group. Groups never share elements, so each view can be processed independently of (and concurrently with) the others:
+
+	template <bool g_is_const> class colony_group_view
+	{
+	private:
+		typedef typename choose<g_is_const, typename colony::const_iterator, typename colony::iterator>::type	view_iterator;
+
+		view_iterator	first, last;
+		size_type		active_size, block_capacity;
+
+		colony_group_view(const view_iterator &begin_it, const view_iterator &end_it, const size_type group_size, const size_type group_capacity) PLF_NOEXCEPT:
+			first(begin_it),
+			last(end_it),
+			active_size(group_size),
+			block_capacity(group_capacity)
+		{}
+
+	public:
+		typedef view_iterator	iterator;
+
+		friend class colony;
+
+		inline iterator begin() const PLF_NOEXCEPT { return first; }
+		inline iterator end() const PLF_NOEXCEPT { return last; }
+		inline size_type size() const PLF_NOEXCEPT { return active_size; } // number of active elements in the group
+		inline size_type capacity() const PLF_NOEXCEPT { return block_capacity; } // number of element slots in the group's memory block
+	}; // colony_group_view
+
+
+
+
 private:
 
 	// Used to prevent fill-insert/constructor calls being mistakenly resolved to range-insert/constructor calls
@@ -3721,6 +3762,216 @@ public:
 
 
 
+private:
+
+	// State of an erase_if pass through a single group. Everything before index has already been rewritten, so if the predicate throws the pass can be completed from here without further erasures:
+	struct erase_if_position
+	{
+		size_type index;							// next element index to examine
+		size_type skipblock_start;				// start index of the skipblock currently being built, or the group's end index if there is none
+		skipfield_type previous_skipblock;	// start index of the last completed skipblock ie. the current free list head, or max if none
+		skipfield_type number_erased;			// number of elements erased from the group so far
+	};
+
+
+
+	struct erase_if_keep_all // Used to complete a group's pass after the predicate throws
+	{
+		template <class visited_type>
+		inline bool operator () (const visited_type &) const PLF_NOEXCEPT
+		{
+			return false;
+		}
+	};
+
+
+
+	// Erases the group's elements which match the predicate, rewriting its skipfield and free list from scratch in a single forward pass. Existing skipblocks are jumped over and merged with newly-erased neighbours. Each completed skipblock gets its start and end nodes set and is appended to the free list, which is then in index order with the head being the highest skipblock:
+	template <class predicate_function>
+	void erase_if_in_group(const group_pointer_type group_pointer, erase_if_position &position, predicate_function &predicate)
+	{
+		const aligned_pointer_type elements = group_pointer->elements;
+		const skipfield_pointer_type skipfield = group_pointer->skipfield;
+		const size_type end_index = static_cast<size_type>(group_pointer->last_endpoint - elements);
+
+		while (position.index != end_index)
+		{
+			const skipfield_type skip = skipfield[position.index];
+
+			if (skip != 0) // start of an existing skipblock
+			{
+				if (position.skipblock_start == end_index)
+				{
+					position.skipblock_start = position.index;
+				}
+
+				position.index += skip;
+			}
+			else if (predicate(reinterpret_cast<reference>(*(elements + position.index))))
+			{
+				#ifdef PLF_TYPE_TRAITS_SUPPORT
+					if PLF_CONSTEXPR (!std::is_trivially_destructible<element_type>::value)
+				#endif
+				{
+					PLF_DESTROY(allocator_type, *this, reinterpret_cast<pointer>(elements + position.index));
+				}
+
+				if (position.skipblock_start == end_index)
+				{
+					position.skipblock_start = position.index;
+				}
+
+				++position.index;
+				++position.number_erased;
+			}
+			else
+			{
+				if (position.skipblock_start != end_index)
+				{
+					complete_skipblock(group_pointer, position, position.index);
+					position.skipblock_start = end_index;
+				}
+
+				++position.index;
+			}
+		}
+
+		if (position.skipblock_start != end_index)
+		{
+			complete_skipblock(group_pointer, position, end_index);
+			position.skipblock_start = end_index;
+		}
+
+		group_pointer->free_list_head = position.previous_skipblock;
+		group_pointer->size = static_cast<skipfield_type>(group_pointer->size - position.number_erased);
+	}
+
+
+
+	void complete_skipblock(const group_pointer_type group_pointer, erase_if_position &position, const size_type skipblock_end) PLF_NOEXCEPT
+	{
+		const skipfield_type start = static_cast<skipfield_type>(position.skipblock_start);
+		group_pointer->skipfield[start] = group_pointer->skipfield[skipblock_end - 1] = static_cast<skipfield_type>(skipblock_end - start);
+
+		const skipfield_pointer_type free_list_node = reinterpret_cast<skipfield_pointer_type>(group_pointer->elements + start);
+		*free_list_node = position.previous_skipblock;
+		*(free_list_node + 1) = std::numeric_limits<skipfield_type>::max();
+
+		if (position.previous_skipblock != std::numeric_limits<skipfield_type>::max())
+		{
+			*(reinterpret_cast<skipfield_pointer_type>(group_pointer->elements + position.previous_skipblock) + 1) = start;
+		}
+
+		position.previous_skipblock = start;
+	}
+
+
+
+	// Following erase_if passes: unlinks emptied groups, renumbers the remaining groups, rebuilds the groups-with-erasures list and resets begin/end. As in erase(), an emptied back group is kept for reuse and, if every group was emptied, the last one is reset and remains as the only group:
+	void consolidate_groups_after_erase_if() PLF_NOEXCEPT
+	{
+		groups_with_erasures_list_head = NULL;
+		group_pointer_type current_group = begin_iterator.group_pointer, previous_group = NULL;
+		size_type group_number = 0;
+
+		while (current_group != NULL)
+		{
+			const group_pointer_type next_group = current_group->next_group;
+
+			if (current_group->size != 0)
+			{
+				current_group->previous_group = previous_group;
+				current_group->group_number = group_number++;
+
+				if (previous_group == NULL)
+				{
+					begin_iterator.group_pointer = current_group;
+				}
+				else
+				{
+					previous_group->next_group = current_group;
+				}
+
+				if (current_group->free_list_head != std::numeric_limits<skipfield_type>::max())
+				{
+					current_group->erasures_list_next_group = groups_with_erasures_list_head;
+					groups_with_erasures_list_head = current_group;
+				}
+
+				previous_group = current_group;
+			}
+			else if (next_group != NULL)
+			{
+				total_capacity -= current_group->capacity;
+				deallocate_group(current_group);
+			}
+			else if (previous_group != NULL)
+			{
+				add_group_to_unused_groups_list(current_group);
+			}
+			else // ie. colony is now empty
+			{
+				begin_iterator.group_pointer = end_iterator.group_pointer = current_group;
+				reset_only_group_left(current_group);
+				return;
+			}
+
+			current_group = next_group;
+		}
+
+		previous_group->next_group = NULL;
+
+		begin_iterator.element_pointer = begin_iterator.group_pointer->elements + *(begin_iterator.group_pointer->skipfield);
+		begin_iterator.skipfield_pointer = begin_iterator.group_pointer->skipfield + *(begin_iterator.group_pointer->skipfield);
+
+		end_iterator.group_pointer = previous_group;
+		end_iterator.element_pointer = previous_group->last_endpoint;
+		end_iterator.skipfield_pointer = previous_group->skipfield + (previous_group->last_endpoint - previous_group->elements);
+	}
+
+
+
+public:
+
+	// Erases every element for which predicate(element) returns true, and returns the number erased. Each group is processed in a single pass which rewrites its skipfield and free list, and emptied groups are released once all groups have been processed, making this considerably cheaper than repeated erase() calls when many elements are removed.
+	// If the predicate throws, the elements already erased stay erased and the colony remains valid.
+	template <class predicate_function>
+	size_type erase_if(predicate_function predicate)
+	{
+		if (total_size == 0)
+		{
+			return 0;
+		}
+
+		const size_type original_size = total_size;
+
+		for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+		{
+			const size_type end_index = static_cast<size_type>(current_group->last_endpoint - current_group->elements);
+			erase_if_position position = {0, end_index, std::numeric_limits<skipfield_type>::max(), 0};
+
+			try
+			{
+				erase_if_in_group(current_group, position, predicate);
+			}
+			catch (...)
+			{
+				erase_if_keep_all keep_all;
+				erase_if_in_group(current_group, position, keep_all);
+				total_size -= position.number_erased;
+				consolidate_groups_after_erase_if();
+				throw;
+			}
+
+			total_size -= position.number_erased;
+		}
+
+		consolidate_groups_after_erase_if();
+		return original_size - total_size;
+	}
+
+
+
 private:
 
 	void prepare_groups_for_assign(const size_type size)
@@ -4427,11 +4678,44 @@ private:
 
 
 
-public:
+	// Sorts the tuple array in sort_impl (std::sort is default sort function if the macro below is not defined):
+	struct default_sort_function
+	{
+		template <class iterator_type, class comparison_function>
+		void operator() (iterator_type first, iterator_type last, comparison_function compare) const
+		{
+			#ifndef PLF_SORT_FUNCTION
+				std::sort(first, last, compare);
+			#else
+				PLF_SORT_FUNCTION(first, last, compare);
+			#endif
+		}
+	};
 
 
-	template <class comparison_function>
-	void sort(comparison_function compare)
+
+	#ifdef PLF_EXECUTION_POLICY_SUPPORT
+		template <class execution_policy>
+		struct policy_sort_function
+		{
+			execution_policy policy;
+
+			explicit policy_sort_function(const execution_policy &policy_instance):
+				policy(policy_instance)
+			{}
+
+			template <class iterator_type, class comparison_function>
+			void operator() (iterator_type first, iterator_type last, comparison_function compare) const
+			{
+				std::sort(policy, first, last, compare);
+			}
+		};
+	#endif
+
+
+
+	template <class comparison_function, class sort_function>
+	void sort_impl(comparison_function compare, sort_function sort_tuples)
 	{
 		if (total_size < 2)
 		{
@@ -4453,12 +4737,8 @@ public:
 			#endif
 		}
 
-		// Now, sort the pointers by the values they point to (std::sort is default sort function if the macro below is not defined):
-		#ifndef PLF_SORT_FUNCTION
-			std::sort(sort_array, sort_array + total_size, sort_dereferencer<comparison_function>(compare));
-		#else
-			PLF_SORT_FUNCTION(sort_array, sort_array + total_size, sort_dereferencer<comparison_function>(compare));
-		#endif
+		// Now, sort the pointers by the values they point to:
+		sort_tuples(sort_array, sort_array + total_size, sort_dereferencer<comparison_function>(compare));
 
 		// Sort the actual elements via the tuple array:
 		index = 0;
@@ -4502,6 +4782,211 @@ public:
 
 
 
+	#if defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALLOCATOR_TRAITS_SUPPORT)
+		template <class key_type>
+		struct key_location_tuple
+		{
+			key_type key;
+			pointer location;
+
+			key_location_tuple(const key_type &_key, const pointer _location):
+				key(_key),
+				location(_location)
+			{}
+		};
+
+
+
+		template <class key_type>
+		struct key_location_less
+		{
+			bool operator() (const key_location_tuple<key_type> &first, const key_location_tuple<key_type> &second) const
+			{
+				return first.key < second.key;
+			}
+		};
+
+
+
+		template <class key_extractor>
+		struct key_extractor_less
+		{
+			key_extractor extract;
+
+			explicit key_extractor_less(const key_extractor &extractor_instance):
+				extract(extractor_instance)
+			{}
+
+			bool operator() (const element_type &first, const element_type &second)
+			{
+				return extract(first) < extract(second);
+			}
+		};
+
+
+
+		// Integral keys are sorted as unsigned integers, with the sign bit flipped for signed types so that negative keys order first:
+		template <class key_type>
+		static typename std::make_unsigned<key_type>::type radix_key(const key_type key, std::true_type) PLF_NOEXCEPT
+		{
+			typedef typename std::make_unsigned<key_type>::type unsigned_key_type;
+			return static_cast<unsigned_key_type>(static_cast<unsigned_key_type>(key) ^ (static_cast<unsigned_key_type>(std::is_signed<key_type>::value) << (sizeof(unsigned_key_type) * 8 - 1)));
+		}
+
+
+
+		template <class key_type>
+		static const key_type & radix_key(const key_type &key, std::false_type) PLF_NOEXCEPT
+		{
+			return key;
+		}
+
+
+
+		// LSD radix sort on 8-bit digits. All digit histograms are built in one pass, and passes in which every key has the same digit are skipped. Returns whichever of the two arrays holds the result:
+		template <class unsigned_key_type>
+		static key_location_tuple<unsigned_key_type> * radix_sort(key_location_tuple<unsigned_key_type> *data, key_location_tuple<unsigned_key_type> *scratch, const size_type size, std::true_type)
+		{
+			const unsigned int digits = sizeof(unsigned_key_type);
+			size_type counts[sizeof(unsigned_key_type)][256] = {};
+
+			for (size_type index = 0; index != size; ++index)
+			{
+				for (unsigned int digit = 0; digit != digits; ++digit)
+				{
+					++counts[digit][static_cast<unsigned char>(data[index].key >> (digit * 8))];
+				}
+			}
+
+			for (unsigned int digit = 0; digit != digits; ++digit)
+			{
+				size_type * const count = counts[digit];
+
+				if (count[static_cast<unsigned char>(data[0].key >> (digit * 8))] == size)
+				{
+					continue;
+				}
+
+				size_type offset = 0;
+
+				for (unsigned int bucket = 0; bucket != 256; ++bucket)
+				{
+					const size_type bucket_size = count[bucket];
+					count[bucket] = offset;
+					offset += bucket_size;
+				}
+
+				for (size_type index = 0; index != size; ++index)
+				{
+					scratch[count[static_cast<unsigned char>(data[index].key >> (digit * 8))]++] = data[index];
+				}
+
+				std::swap(data, scratch);
+			}
+
+			return data;
+		}
+
+
+
+		template <class key_type>
+		static key_location_tuple<key_type> * radix_sort(key_location_tuple<key_type> *data, key_location_tuple<key_type> *, const size_type size, std::false_type)
+		{
+			std::sort(data, data + size, key_location_less<key_type>());
+			return data;
+		}
+
+
+
+		template <class key_extractor>
+		void sort_by_key_impl(key_extractor extract, std::false_type)
+		{
+			sort(key_extractor_less<key_extractor>(extract));
+		}
+
+
+
+		template <class key_extractor>
+		void sort_by_key_impl(key_extractor extract, std::true_type)
+		{
+			if (total_size < 2)
+			{
+				return;
+			}
+
+			typedef typename std::decay<decltype(extract(std::declval<const element_type &>()))>::type key_type;
+			typedef std::integral_constant<bool, std::is_integral<key_type>::value && !std::is_same<key_type, bool>::value> use_radix;
+			typedef typename std::decay<decltype(radix_key(std::declval<key_type>(), use_radix()))>::type sort_key_type;
+			typedef key_location_tuple<sort_key_type> tuple_type;
+			typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<tuple_type> key_tuple_allocator_type;
+
+			key_tuple_allocator_type key_tuple_allocator(*this);
+			tuple_type * const tuples = &*std::allocator_traits<key_tuple_allocator_type>::allocate(key_tuple_allocator, total_size * 2);
+			tuple_type *current_tuple = tuples;
+			tuple_type *sorted;
+			pointer buffer;
+
+			try
+			{
+				// Extract every key once, into contiguous memory:
+				for (iterator current_element = begin_iterator; current_element != end_iterator; ++current_element, ++current_tuple)
+				{
+					std::allocator_traits<key_tuple_allocator_type>::construct(key_tuple_allocator, current_tuple, radix_key(extract(*current_element), use_radix()), &*current_element);
+				}
+
+				sorted = radix_sort(tuples, tuples + total_size, total_size, use_radix());
+
+				// Gather the elements in sorted order into a buffer, then copy them back over the colony in iteration order:
+				buffer = PLF_ALLOCATE(allocator_type, *this, total_size, NULL);
+			}
+			catch (...)
+			{
+				// The colony is untouched until here; only the keys constructed so far need destroying:
+				for (tuple_type *constructed = tuples; constructed != current_tuple; ++constructed)
+				{
+					std::allocator_traits<key_tuple_allocator_type>::destroy(key_tuple_allocator, constructed);
+				}
+
+				std::allocator_traits<key_tuple_allocator_type>::deallocate(key_tuple_allocator, tuples, total_size * 2);
+				throw;
+			}
+
+			for (size_type index = 0; index != total_size; ++index)
+			{
+				std::memcpy(static_cast<void *>(&buffer[index]), static_cast<const void *>(&*sorted[index].location), sizeof(element_type));
+			}
+
+			size_type index = 0;
+
+			for (iterator current_element = begin_iterator; current_element != end_iterator; ++current_element, ++index)
+			{
+				std::memcpy(static_cast<void *>(&*current_element), static_cast<const void *>(&buffer[index]), sizeof(element_type));
+			}
+
+			PLF_DEALLOCATE(allocator_type, *this, buffer, total_size);
+
+			for (current_tuple = sorted; current_tuple != sorted + total_size; ++current_tuple)
+			{
+				std::allocator_traits<key_tuple_allocator_type>::destroy(key_tuple_allocator, current_tuple);
+			}
+
+			std::allocator_traits<key_tuple_allocator_type>::deallocate(key_tuple_allocator, tuples, total_size * 2);
+		}
+	#endif
+
+
+
+public:
+
+
+	template <class comparison_function>
+	void sort(comparison_function compare)
+	{
+		sort_impl(compare, default_sort_function());
+	}
+
+
+
 	inline void sort()
 	{
 		sort(less());
@@ -4509,6 +4994,226 @@ public:
 
 
 
+	#ifdef PLF_EXECUTION_POLICY_SUPPORT
+		// As sort(compare), but the pointer array is sorted by std::sort under the given execution policy, eg. std::execution::par_unseq:
+		template <class execution_policy, class comparison_function>
+		typename std::enable_if<std::is_execution_policy<typename std::decay<execution_policy>::type>::value>::type sort(execution_policy &&policy, comparison_function compare)
+		{
+			sort_impl(compare, policy_sort_function<typename std::decay<execution_policy>::type>(policy));
+		}
+	#endif
+
+
+
+	#if defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALLOCATOR_TRAITS_SUPPORT)
+		// Sorts the elements by the key that extract(element) returns, using operator < on the keys.
+		// For trivially copyable element types, each key is extracted only once into a contiguous array which is sorted directly (with a radix sort for integral keys), and the elements are then gathered into place through a buffer.
+		// For other element types this is equivalent to sort() with a comparator which extracts both keys.
+		template <class key_extractor>
+		void sort_by_key(key_extractor extract)
+		{
+			sort_by_key_impl(extract, std::integral_constant<bool, std::is_trivially_copyable<element_type>::value>());
+		}
+	#endif
+
+
+
+private:
+
+	template <class view_type>
+	view_type make_group_view(const group_pointer_type group_pointer) const PLF_NOEXCEPT
+	{
+		typedef typename view_type::iterator view_iterator;
+		const group_pointer_type next_group = group_pointer->next_group;
+
+		// The view's end is the first element of the next group (or end() for the back group), so that the view's iterators behave exactly like the container's:
+		return view_type(view_iterator(group_pointer, group_pointer->elements + *(group_pointer->skipfield), group_pointer->skipfield + *(group_pointer->skipfield)),
+			(next_group == NULL) ? view_iterator(end_iterator) : view_iterator(next_group, next_group->elements + *(next_group->skipfield), next_group->skipfield + *(next_group->skipfield)),
+			group_pointer->size, group_pointer->capacity);
+	}
+
+
+
+	// Calls func on every active element of the group. Rather than incrementing an iterator, this reads the skipfield once per element to find the end of each run of active elements, then visits the run with a plain pointer loop. A group with no erased elements below last_endpoint is a single run:
+	template <class value_reference, class function_type>
+	static void visit_group(const group_pointer_type group_pointer, function_type &func)
+	{
+		const aligned_pointer_type elements = group_pointer->elements;
+		const size_type end_index = static_cast<size_type>(group_pointer->last_endpoint - elements);
+
+		if (group_pointer->size == end_index)
+		{
+			for (aligned_pointer_type current = elements, end = group_pointer->last_endpoint; current != end; ++current)
+			{
+				func(reinterpret_cast<value_reference>(*current));
+			}
+
+			return;
+		}
+
+		const skipfield_pointer_type skipfield = group_pointer->skipfield;
+		size_type index = *skipfield;
+
+		while (index != end_index)
+		{
+			size_type run_end = index + 1;
+
+			while (run_end != end_index && skipfield[run_end] == 0)
+			{
+				++run_end;
+			}
+
+			for (aligned_pointer_type current = elements + index, end = elements + run_end; current != end; ++current)
+			{
+				func(reinterpret_cast<value_reference>(*current));
+			}
+
+			index = run_end + skipfield[run_end]; // skipfield[end_index] is always zero, either as the unused node past last_endpoint or as the extra trailing node
+		}
+	}
+
+
+
+	template <class predicate_function, class function_type>
+	struct visit_if_function
+	{
+		predicate_function &predicate;
+		function_type &func;
+
+		visit_if_function(predicate_function &pred, function_type &function) PLF_NOEXCEPT: predicate(pred), func(function) {}
+
+		template <class visited_type>
+		void operator () (visited_type &value)
+		{
+			if (predicate(value))
+			{
+				func(value);
+			}
+		}
+	};
+
+
+
+public:
+
+	// Calls func(view) for each memory block (group) of the colony in iteration order, where view is a group_view over that block's active elements. Empty blocks are skipped.
+	template <class function_type>
+	void for_each_group(function_type func)
+	{
+		for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+		{
+			if (current_group->size != 0)
+			{
+				func(make_group_view<group_view>(current_group));
+			}
+		}
+	}
+
+
+
+	template <class function_type>
+	void for_each_group(function_type func) const
+	{
+		for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+		{
+			if (current_group->size != 0)
+			{
+				func(make_group_view<const_group_view>(current_group));
+			}
+		}
+	}
+
+
+
+	// Calls func(element) for each element in iteration order. Equivalent to a loop over begin() to end(), but each group's runs of active elements are visited with plain pointer loops, which compilers can unroll and vectorize. func must not insert into or erase from the colony.
+	template <class function_type>
+	void visit(function_type func)
+	{
+		for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+		{
+			visit_group<reference>(current_group, func);
+		}
+	}
+
+
+
+	template <class function_type>
+	void visit(function_type func) const
+	{
+		for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+		{
+			visit_group<const_reference>(current_group, func);
+		}
+	}
+
+
+
+	// As visit(func), but func is only called for elements where predicate(element) is true:
+	template <class predicate_function, class function_type>
+	void visit_if(predicate_function predicate, function_type func)
+	{
+		visit(visit_if_function<predicate_function, function_type>(predicate, func));
+	}
+
+
+
+	template <class predicate_function, class function_type>
+	void visit_if(predicate_function predicate, function_type func) const
+	{
+		visit(visit_if_function<predicate_function, function_type>(predicate, func));
+	}
+
+
+
+	#ifdef PLF_EXECUTION_POLICY_SUPPORT
+		// Calls func(element) for each element, with the groups distributed as independent work items by std::for_each under the given execution policy (eg. std::execution::par). Elements within a group are visited sequentially, as by visit(). As with the standard parallel algorithms, func must not insert into or erase from the colony, and an exception escaping func calls std::terminate.
+		template <class execution_policy, class function_type>
+		typename std::enable_if<std::is_execution_policy<typename std::decay<execution_policy>::type>::value>::type for_each(execution_policy &&policy, function_type func)
+		{
+			size_type number_of_groups = 0;
+
+			for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+			{
+				number_of_groups += (current_group->size != 0);
+			}
+
+			if (number_of_groups == 0)
+			{
+				return;
+			}
+
+			uchar_allocator_type uchar_allocator(*this);
+			group_pointer_type * const groups = reinterpret_cast<group_pointer_type *>(PLF_ALLOCATE(uchar_allocator_type, uchar_allocator, number_of_groups * sizeof(group_pointer_type), NULL));
+			group_pointer_type *group_location = groups;
+
+			for (group_pointer_type current_group = begin_iterator.group_pointer; current_group != NULL; current_group = current_group->next_group)
+			{
+				if (current_group->size != 0)
+				{
+					*group_location++ = current_group;
+				}
+			}
+
+			try
+			{
+				std::for_each(std::forward<execution_policy>(policy), groups, groups + number_of_groups, [&func](const group_pointer_type current_group)
+				{
+					function_type group_func(func);
+					visit_group<reference>(current_group, group_func);
+				});
+			}
+			catch (...)
+			{
+				PLF_DEALLOCATE(uchar_allocator_type, uchar_allocator, reinterpret_cast<unsigned char *>(groups), number_of_groups * sizeof(group_pointer_type));
+				throw;
+			}
+
+			PLF_DEALLOCATE(uchar_allocator_type, uchar_allocator, reinterpret_cast<unsigned char *>(groups), number_of_groups * sizeof(group_pointer_type));
+		}
+	#endif
+
+
+
 	struct colony_data : public uchar_allocator_type
 	{
 		aligned_pointer_type * const block_pointers;				// array of pointers to element memory blocks
@@ -4686,44 +5391,9 @@ namespace std
 
 
 	template <class element_type, class allocator_type, plf::colony_priority priority, class predicate_function>
-	typename plf::colony<element_type, allocator_type, priority>::size_type erase_if(plf::colony<element_type, allocator_type, priority> &container, predicate_function predicate)
+	inline typename plf::colony<element_type, allocator_type, priority>::size_type erase_if(plf::colony<element_type, allocator_type, priority> &container, predicate_function predicate)
 	{
-		typedef typename plf::colony<element_type, allocator_type, priority> colony;
-		typedef typename colony::const_iterator 	const_iterator;
-		typedef typename colony::size_type 			size_type;
-		size_type count = 0;
-
-		for(const_iterator current = container.begin(), end = container.end(); current != end;)
-		{
-			if (predicate(*current))
-			{
-				const size_type original_count = ++count;
-				const_iterator last(++const_iterator(current));
-
-				while(last != end && predicate(*last))
-				{
-					++last;
-					++count;
-				}
-
-				if (count != original_count)
-				{
-					current = container.erase(current, last);
-				}
-				else
-				{
-					current = container.erase(current);
-				}
-
-				end = container.end();
-			}
-			else
-			{
-				++current;
-			}
-		}
-
-		return count;
+		return container.erase_if(predicate);
 	}
 
 
@@ -4751,6 +5421,7 @@ namespace std
 #undef PLF_NOEXCEPT_MOVE_ASSIGN
 #undef PLF_CONSTEXPR
 #undef PLF_CPP20_SUPPORT
+#undef PLF_EXECUTION_POLICY_SUPPORT
 #undef PLF_STATIC_ASSERT
 
 #undef PLF_CONSTRUCT
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <type_traits>
 #include <iterator>
+#include <new>
+#include <utility>
 #include <cassert>
 
 namespace sg14
@@ -31,6 +34,28 @@ namespace sg14
 	template <typename, bool>
 	class ring_iterator;
 
+	// A contiguous run of slots inside a ring's storage.
+	template <typename T>
+	struct ring_segment
+	{
+		T* data;
+		std::size_t size;
+
+		T* begin() const noexcept;
+		T* end() const noexcept;
+	};
+
+	// The (at most two) contiguous runs that make up a range of slots in a
+	// ring, in ring order. second is empty unless the range wraps.
+	template <typename T>
+	struct ring_segments
+	{
+		ring_segment<T> first;
+		ring_segment<T> second;
+
+		std::size_t size() const noexcept;
+	};
+
 	template<typename T, class Popper = default_popper<T>>
 	class ring_span
 	{
@@ -90,6 +115,17 @@ namespace sg14
 		void emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
 		auto pop_front();
 
+		// Bulk access. write_segments(n) returns the n slots past the back,
+		// which commit(n) then appends; as with push_back, committing more than
+		// capacity() - size() slots overwrites the front. read_segments(n)
+		// returns the first n elements, which consume(n) then pops, passing
+		// each through the popper and discarding the result.
+		ring_segments<T> write_segments(size_type n) noexcept;
+		void commit(size_type n) noexcept;
+		ring_segments<T> read_segments(size_type n) noexcept;
+		ring_segments<const T> read_segments(size_type n) const noexcept;
+		void consume(size_type n);
+
 		void swap(type& rhs) noexcept;// (std::is_nothrow_swappable<Popper>::value);
 
 		// Example implementation
@@ -98,6 +134,8 @@ namespace sg14
 		const_reference at(size_type idx) const noexcept;
 		size_type back_idx() const noexcept;
 		void increase_size() noexcept;
+		template <typename U>
+		ring_segments<U> segments(U* data, size_type idx, size_type n) const noexcept;
 
 		T* m_data;
 		size_type m_size;
@@ -109,6 +147,318 @@ namespace sg14
 	template<typename T, class Popper>
 	void swap(ring_span<T, Popper>&, ring_span<T, Popper>&) noexcept;
 
+	// A ring_span whose capacity must be a power of two. Indices wrap with a
+	// mask instead of a division, and the front and back are free-running
+	// counters whose difference is the size, so a full ring and an empty one
+	// need no extra state to tell apart.
+	template<typename T, class Popper = default_popper<T>>
+	class pow2_ring_span
+	{
+	public:
+		using type = pow2_ring_span<T, Popper>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = ring_iterator<type, false>;
+		using const_iterator = ring_iterator<type, true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		friend class ring_iterator<type, false>;
+		friend class ring_iterator<type, true>;
+
+		template <class ContiguousIterator>
+		pow2_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p = Popper()) noexcept;
+
+		template <class ContiguousIterator>
+		pow2_ring_span(ContiguousIterator begin, ContiguousIterator end, ContiguousIterator first, size_type size, Popper p = Popper()) noexcept;
+
+		pow2_ring_span(pow2_ring_span&&) = default;
+		pow2_ring_span& operator=(pow2_ring_span&&) = default;
+
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		reference front() noexcept;
+		const_reference front() const noexcept;
+		reference back() noexcept;
+		const_reference back() const noexcept;
+
+		iterator begin() noexcept;
+		const_iterator begin() const noexcept;
+		iterator end() noexcept;
+		const_iterator end() const noexcept;
+
+		const_iterator cbegin() const noexcept;
+		const_reverse_iterator crbegin() const noexcept;
+		reverse_iterator rbegin() noexcept;
+		const_reverse_iterator rbegin() const noexcept;
+		const_iterator cend() const noexcept;
+		const_reverse_iterator crend() const noexcept;
+		reverse_iterator rend() noexcept;
+		const_reverse_iterator rend() const noexcept;
+
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_assignable<T>::value>>
+		void push_back(const value_type& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		void push_back(value_type&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+		template<class... FromType>
+		void emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
+		auto pop_front();
+
+		ring_segments<T> write_segments(size_type n) noexcept;
+		void commit(size_type n) noexcept;
+		ring_segments<T> read_segments(size_type n) noexcept;
+		ring_segments<const T> read_segments(size_type n) const noexcept;
+		void consume(size_type n);
+
+		void swap(type& rhs) noexcept;
+
+		// Example implementation
+	private:
+		reference at(size_type idx) noexcept;
+		const_reference at(size_type idx) const noexcept;
+		void increase_size() noexcept;
+		template <typename U>
+		ring_segments<U> segments(U* data, size_type idx, size_type n) const noexcept;
+
+		T* m_data;
+		size_type m_mask;
+		size_type m_front;
+		size_type m_back;
+		Popper m_popper;
+	};
+
+	template<typename T, class Popper>
+	void swap(pow2_ring_span<T, Popper>&, pow2_ring_span<T, Popper>&) noexcept;
+
+	// A ring that owns inline storage for N elements. Unlike ring_span, slots
+	// hold no object until one is pushed, and elements are constructed and
+	// destroyed in place, so T need not be default constructible or
+	// assignable. Pushing to a full ring destroys the front element first.
+	template<typename T, std::size_t N>
+	class static_ring
+	{
+		static_assert(N > 0, "static_ring needs room for at least one element");
+
+	public:
+		using type = static_ring<T, N>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = ring_iterator<type, false>;
+		using const_iterator = ring_iterator<type, true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		friend class ring_iterator<type, false>;
+		friend class ring_iterator<type, true>;
+
+		static_ring() noexcept;
+		static_ring(const static_ring& rhs);
+		static_ring(static_ring&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+		static_ring& operator=(const static_ring& rhs);
+		static_ring& operator=(static_ring&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+		~static_ring();
+
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		static constexpr size_type capacity() noexcept;
+
+		reference front() noexcept;
+		const_reference front() const noexcept;
+		reference back() noexcept;
+		const_reference back() const noexcept;
+
+		iterator begin() noexcept;
+		const_iterator begin() const noexcept;
+		iterator end() noexcept;
+		const_iterator end() const noexcept;
+
+		const_iterator cbegin() const noexcept;
+		const_reverse_iterator crbegin() const noexcept;
+		reverse_iterator rbegin() noexcept;
+		const_reverse_iterator rbegin() const noexcept;
+		const_iterator cend() const noexcept;
+		const_reverse_iterator crend() const noexcept;
+		reverse_iterator rend() noexcept;
+		const_reverse_iterator rend() const noexcept;
+
+		void push_back(const value_type& from_value);
+		void push_back(value_type&& from_value);
+		template<class... FromType>
+		reference emplace_back(FromType&&... from_value);
+		value_type pop_front();
+		void clear() noexcept;
+
+		// Example implementation
+	private:
+		reference at(size_type idx) noexcept;
+		const_reference at(size_type idx) const noexcept;
+		void* storage(size_type idx) noexcept;
+		T* slot(size_type idx) noexcept;
+		const T* slot(size_type idx) const noexcept;
+		void destroy_front() noexcept;
+
+		std::aligned_storage_t<sizeof(T), alignof(T)> m_storage[N];
+		size_type m_size;
+		size_type m_front_idx;
+	};
+
+	// A ring over user-supplied storage for exactly one producer thread and
+	// one consumer thread, which may run concurrently without further
+	// synchronization. Unlike ring_span, pushing to a full ring fails rather
+	// than overwriting the front element.
+	template<typename T, class Popper = default_popper<T>>
+	class spsc_ring_span
+	{
+	public:
+		using type = spsc_ring_span<T, Popper>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using const_reference = const T&;
+
+		template <class ContiguousIterator>
+		spsc_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p = Popper()) noexcept;
+
+		spsc_ring_span(const spsc_ring_span&) = delete;
+		spsc_ring_span& operator=(const spsc_ring_span&) = delete;
+
+		// Consistent snapshots only when called from the producer or the consumer.
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		// Producer side.
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_assignable<T>::value>>
+		bool try_push(const value_type& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		bool try_push(value_type&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+		template<class... FromType>
+		bool try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
+
+		// Consumer side. The first overload discards the popped value, the
+		// second assigns it to the argument.
+		bool try_pop();
+		template<class U>
+		bool try_pop(U& to_value);
+
+		// Example implementation
+	private:
+		static constexpr size_type cache_line_size = 64;
+
+		size_type wrap(size_type idx) const noexcept;
+		size_type next(size_type counter) const noexcept;
+		size_type distance(size_type from, size_type to) const noexcept;
+		template<class Assign>
+		bool push_with(Assign&& assign);
+
+		// Head and tail run over [0, 2 * capacity), so that a full ring and an
+		// empty one are told apart without wasting a slot. Each side keeps a
+		// cached copy of the other's counter, refreshed only when the cached
+		// value suggests the ring is full (or empty).
+		T* m_data;
+		size_type m_capacity;
+		Popper m_popper;
+		alignas(cache_line_size) std::atomic<size_type> m_head;
+		size_type m_cached_tail;
+		alignas(cache_line_size) std::atomic<size_type> m_tail;
+		size_type m_cached_head;
+	};
+
+	// One slot of an mpmc_ring_span. The sequence number tells producers and
+	// consumers whose turn it is to touch value.
+	template<typename T>
+	struct mpmc_ring_cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	// A bounded queue over user-supplied storage for any number of producer
+	// and consumer threads, after Dmitry Vyukov's bounded MPMC queue. The
+	// storage is a contiguous range of mpmc_ring_cell<T>, whose sequence
+	// numbers the constructor initializes.
+	//
+	// A claimed cell must always be released, or every thread that later
+	// reaches it would spin on it. Pushes therefore build their value before
+	// claiming a cell and only move-assign into it, which must not throw. If
+	// the popper throws, the cell is released anyway and the element is lost.
+	template<typename T, class Popper = default_popper<T>>
+	class mpmc_ring_span
+	{
+		static_assert(std::is_nothrow_move_assignable<T>::value, "mpmc_ring_span cannot release a cell whose move assignment threw");
+
+	public:
+		using type = mpmc_ring_span<T, Popper>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using cell_type = mpmc_ring_cell<T>;
+
+		template <class ContiguousIterator>
+		mpmc_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p = Popper()) noexcept;
+
+		mpmc_ring_span(const mpmc_ring_span&) = delete;
+		mpmc_ring_span& operator=(const mpmc_ring_span&) = delete;
+
+		// Snapshots; only exact while no other thread is pushing or popping.
+		bool empty() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_constructible<T>::value>>
+		bool try_push(const value_type& from_value) noexcept(std::is_nothrow_copy_constructible<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		bool try_push(value_type&& from_value) noexcept;
+		template<class... FromType>
+		bool try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value);
+
+		bool try_pop();
+		template<class U>
+		bool try_pop(U& to_value);
+
+		// Example implementation
+	private:
+		static constexpr size_type cache_line_size = 64;
+
+		// Hands a popped cell on to the producers of the next lap, even if
+		// the popper throws.
+		struct pop_release
+		{
+			cell_type* cell;
+			size_type capacity;
+
+			~pop_release()
+			{
+				cell->sequence.store(cell->sequence.load(std::memory_order_relaxed) - 1 + capacity, std::memory_order_release);
+			}
+		};
+
+		cell_type* claim_for_push() noexcept;
+		cell_type* claim_for_pop() noexcept;
+
+		// The positions run freely; a slot's index is its position modulo the
+		// capacity. A cell whose sequence equals a producer's position is free
+		// to write, and one whose sequence equals a consumer's position + 1 is
+		// ready to read. Both the push and the pop then release the cell for
+		// the next lap.
+		cell_type* m_cells;
+		size_type m_capacity;
+		Popper m_popper;
+		alignas(cache_line_size) std::atomic<size_type> m_push_pos;
+		alignas(cache_line_size) std::atomic<size_type> m_pop_pos;
+	};
+
 	template <typename Ring, bool is_const>
 	class ring_iterator
 	{
@@ -190,6 +540,24 @@ T sg14::copy_popper<T>::operator()(T& t) const
 	return old;
 }
 
+template <typename T>
+T* sg14::ring_segment<T>::begin() const noexcept
+{
+	return data;
+}
+
+template <typename T>
+T* sg14::ring_segment<T>::end() const noexcept
+{
+	return data + size;
+}
+
+template <typename T>
+std::size_t sg14::ring_segments<T>::size() const noexcept
+{
+	return first.size + second.size;
+}
+
 template<typename T, class Popper>
 template<class ContiguousIterator>
 sg14::ring_span<T, Popper>::ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
@@ -364,6 +732,64 @@ auto sg14::ring_span<T, Popper>::pop_front()
 	return m_popper(m_data[old_front_idx]);
 }
 
+template<typename T, class Popper>
+sg14::ring_segments<T> sg14::ring_span<T, Popper>::write_segments(size_type n) noexcept
+{
+	assert(n <= m_capacity);
+	return segments(m_data, back_idx(), n);
+}
+
+template<typename T, class Popper>
+void sg14::ring_span<T, Popper>::commit(size_type n) noexcept
+{
+	assert(n <= m_capacity);
+	m_size += n;
+	if (m_size > m_capacity)
+	{
+		m_front_idx += m_size - m_capacity;
+		if (m_front_idx >= m_capacity)
+		{
+			m_front_idx -= m_capacity;
+		}
+		m_size = m_capacity;
+	}
+}
+
+template<typename T, class Popper>
+sg14::ring_segments<T> sg14::ring_span<T, Popper>::read_segments(size_type n) noexcept
+{
+	assert(n <= m_size);
+	return segments(m_data, m_front_idx, n);
+}
+
+template<typename T, class Popper>
+sg14::ring_segments<const T> sg14::ring_span<T, Popper>::read_segments(size_type n) const noexcept
+{
+	assert(n <= m_size);
+	return segments(static_cast<const T*>(m_data), m_front_idx, n);
+}
+
+template<typename T, class Popper>
+void sg14::ring_span<T, Popper>::consume(size_type n)
+{
+	assert(n <= m_size);
+	auto segs = segments(m_data, m_front_idx, n);
+	for (T& t : segs.first)
+	{
+		m_popper(t);
+	}
+	for (T& t : segs.second)
+	{
+		m_popper(t);
+	}
+	m_front_idx += n;
+	if (m_front_idx >= m_capacity)
+	{
+		m_front_idx -= m_capacity;
+	}
+	m_size -= n;
+}
+
 template<typename T, class Popper>
 void sg14::ring_span<T, Popper>::swap(sg14::ring_span<T, Popper>& rhs) noexcept//(std::is_nothrow_swappable<Popper>::value)
 {
@@ -403,41 +829,876 @@ void sg14::ring_span<T, Popper>::increase_size() noexcept
 	}
 }
 
-template <typename Ring, bool is_const>
-sg14::ring_iterator<Ring, is_const>::operator sg14::ring_iterator<Ring, true>() const noexcept
+template<typename T, class Popper>
+template<typename U>
+sg14::ring_segments<U> sg14::ring_span<T, Popper>::segments(U* data, size_type idx, size_type n) const noexcept
 {
-	return sg14::ring_iterator<Ring, true>(m_idx, m_rv);
+	size_type first_size = n < m_capacity - idx ? n : m_capacity - idx;
+	return ring_segments<U>{ { data + idx, first_size }, { data, n - first_size } };
 }
 
-template <typename Ring, bool is_const>
-template<bool C>
-bool sg14::ring_iterator<Ring, is_const>::operator==(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::pow2_ring_span<T, Popper>::pow2_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
+	: m_data(&*begin)
+	, m_mask(end - begin - 1)
+	, m_front(0)
+	, m_back(0)
+	, m_popper(std::move(p))
 {
-	return (m_idx == rhs.m_idx) && (m_rv == rhs.m_rv);
+	assert(end - begin > 0 && ((end - begin) & (end - begin - 1)) == 0);
 }
 
-template <typename Ring, bool is_const>
-template<bool C>
-bool sg14::ring_iterator<Ring, is_const>::operator!=(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::pow2_ring_span<T, Popper>::pow2_ring_span(ContiguousIterator begin, ContiguousIterator end, ContiguousIterator first, size_type size, Popper p) noexcept
+	: m_data(&*begin)
+	, m_mask(end - begin - 1)
+	, m_front(first - begin)
+	, m_back(first - begin + size)
+	, m_popper(std::move(p))
 {
-	return !(*this == rhs);
+	assert(end - begin > 0 && ((end - begin) & (end - begin - 1)) == 0);
 }
 
-template <typename Ring, bool is_const>
-template<bool C>
-bool sg14::ring_iterator<Ring, is_const>::operator<(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+template<typename T, class Popper>
+bool sg14::pow2_ring_span<T, Popper>::empty() const noexcept
 {
-	return (m_idx < rhs.m_idx) && (m_rv == rhs.m_rv);
+	return m_back == m_front;
 }
 
-template <typename Ring, bool is_const>
-template<bool C>
-bool sg14::ring_iterator<Ring, is_const>::operator<=(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+template<typename T, class Popper>
+bool sg14::pow2_ring_span<T, Popper>::full() const noexcept
 {
-	return !(rhs < *this);
+	return size() == capacity();
 }
 
-template <typename Ring, bool is_const>
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::size_type sg14::pow2_ring_span<T, Popper>::size() const noexcept
+{
+	return m_back - m_front;
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::size_type sg14::pow2_ring_span<T, Popper>::capacity() const noexcept
+{
+	return m_mask + 1;
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::reference sg14::pow2_ring_span<T, Popper>::front() noexcept
+{
+	return at(m_front);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reference sg14::pow2_ring_span<T, Popper>::front() const noexcept
+{
+	return at(m_front);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::reference sg14::pow2_ring_span<T, Popper>::back() noexcept
+{
+	return at(m_back - 1);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reference sg14::pow2_ring_span<T, Popper>::back() const noexcept
+{
+	return at(m_back - 1);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::iterator sg14::pow2_ring_span<T, Popper>::begin() noexcept
+{
+	return iterator(m_front, this);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_iterator sg14::pow2_ring_span<T, Popper>::begin() const noexcept
+{
+	return const_iterator(m_front, this);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::iterator sg14::pow2_ring_span<T, Popper>::end() noexcept
+{
+	return iterator(m_back, this);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_iterator sg14::pow2_ring_span<T, Popper>::end() const noexcept
+{
+	return const_iterator(m_back, this);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_iterator sg14::pow2_ring_span<T, Popper>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::reverse_iterator sg14::pow2_ring_span<T, Popper>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reverse_iterator sg14::pow2_ring_span<T, Popper>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reverse_iterator sg14::pow2_ring_span<T, Popper>::crbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_iterator sg14::pow2_ring_span<T, Popper>::cend() const noexcept
+{
+	return end();
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::reverse_iterator sg14::pow2_ring_span<T, Popper>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reverse_iterator sg14::pow2_ring_span<T, Popper>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reverse_iterator sg14::pow2_ring_span<T, Popper>::crend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+void sg14::pow2_ring_span<T, Popper>::push_back(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value)
+{
+	at(m_back) = value;
+	increase_size();
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+void sg14::pow2_ring_span<T, Popper>::push_back(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	at(m_back) = std::move(value);
+	increase_size();
+}
+
+template<typename T, class Popper>
+template<class... FromType>
+void sg14::pow2_ring_span<T, Popper>::emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value)
+{
+	at(m_back) = T(std::forward<FromType>(from_value)...);
+	increase_size();
+}
+
+template<typename T, class Popper>
+auto sg14::pow2_ring_span<T, Popper>::pop_front()
+{
+	assert(!empty());
+	return m_popper(at(m_front++));
+}
+
+template<typename T, class Popper>
+sg14::ring_segments<T> sg14::pow2_ring_span<T, Popper>::write_segments(size_type n) noexcept
+{
+	assert(n <= capacity());
+	return segments(m_data, m_back & m_mask, n);
+}
+
+template<typename T, class Popper>
+void sg14::pow2_ring_span<T, Popper>::commit(size_type n) noexcept
+{
+	assert(n <= capacity());
+	m_back += n;
+	if (size() > capacity())
+	{
+		m_front = m_back - capacity();
+	}
+}
+
+template<typename T, class Popper>
+sg14::ring_segments<T> sg14::pow2_ring_span<T, Popper>::read_segments(size_type n) noexcept
+{
+	assert(n <= size());
+	return segments(m_data, m_front & m_mask, n);
+}
+
+template<typename T, class Popper>
+sg14::ring_segments<const T> sg14::pow2_ring_span<T, Popper>::read_segments(size_type n) const noexcept
+{
+	assert(n <= size());
+	return segments(static_cast<const T*>(m_data), m_front & m_mask, n);
+}
+
+template<typename T, class Popper>
+void sg14::pow2_ring_span<T, Popper>::consume(size_type n)
+{
+	assert(n <= size());
+	auto segs = segments(m_data, m_front & m_mask, n);
+	for (T& t : segs.first)
+	{
+		m_popper(t);
+	}
+	for (T& t : segs.second)
+	{
+		m_popper(t);
+	}
+	m_front += n;
+}
+
+template<typename T, class Popper>
+void sg14::pow2_ring_span<T, Popper>::swap(sg14::pow2_ring_span<T, Popper>& rhs) noexcept
+{
+	using std::swap;
+	swap(m_data, rhs.m_data);
+	swap(m_mask, rhs.m_mask);
+	swap(m_front, rhs.m_front);
+	swap(m_back, rhs.m_back);
+	swap(m_popper, rhs.m_popper);
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::reference sg14::pow2_ring_span<T, Popper>::at(size_type i) noexcept
+{
+	return m_data[i & m_mask];
+}
+
+template<typename T, class Popper>
+typename sg14::pow2_ring_span<T, Popper>::const_reference sg14::pow2_ring_span<T, Popper>::at(size_type i) const noexcept
+{
+	return m_data[i & m_mask];
+}
+
+template<typename T, class Popper>
+void sg14::pow2_ring_span<T, Popper>::increase_size() noexcept
+{
+	if (++m_back - m_front > capacity())
+	{
+		++m_front;
+	}
+}
+
+template<typename T, class Popper>
+template<typename U>
+sg14::ring_segments<U> sg14::pow2_ring_span<T, Popper>::segments(U* data, size_type idx, size_type n) const noexcept
+{
+	size_type first_size = n < capacity() - idx ? n : capacity() - idx;
+	return ring_segments<U>{ { data + idx, first_size }, { data, n - first_size } };
+}
+
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>::static_ring() noexcept
+	: m_size(0)
+	, m_front_idx(0)
+{}
+
+// The copy and move constructors delegate, so that the destructor cleans up
+// the elements already constructed if one of them throws.
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>::static_ring(const static_ring& rhs)
+	: static_ring()
+{
+	for (const T& t : rhs)
+	{
+		emplace_back(t);
+	}
+}
+
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>::static_ring(static_ring&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+	: static_ring()
+{
+	for (T& t : rhs)
+	{
+		emplace_back(std::move(t));
+	}
+}
+
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>& sg14::static_ring<T, N>::operator=(const static_ring& rhs)
+{
+	if (this != &rhs)
+	{
+		clear();
+		for (const T& t : rhs)
+		{
+			emplace_back(t);
+		}
+	}
+	return *this;
+}
+
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>& sg14::static_ring<T, N>::operator=(static_ring&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+	if (this != &rhs)
+	{
+		clear();
+		for (T& t : rhs)
+		{
+			emplace_back(std::move(t));
+		}
+	}
+	return *this;
+}
+
+template<typename T, std::size_t N>
+sg14::static_ring<T, N>::~static_ring()
+{
+	clear();
+}
+
+template<typename T, std::size_t N>
+bool sg14::static_ring<T, N>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template<typename T, std::size_t N>
+bool sg14::static_ring<T, N>::full() const noexcept
+{
+	return m_size == N;
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::size_type sg14::static_ring<T, N>::size() const noexcept
+{
+	return m_size;
+}
+
+template<typename T, std::size_t N>
+constexpr typename sg14::static_ring<T, N>::size_type sg14::static_ring<T, N>::capacity() noexcept
+{
+	return N;
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::reference sg14::static_ring<T, N>::front() noexcept
+{
+	return *begin();
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reference sg14::static_ring<T, N>::front() const noexcept
+{
+	return *begin();
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::reference sg14::static_ring<T, N>::back() noexcept
+{
+	return *(--end());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reference sg14::static_ring<T, N>::back() const noexcept
+{
+	return *(--end());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::iterator sg14::static_ring<T, N>::begin() noexcept
+{
+	return iterator(m_front_idx, this);
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_iterator sg14::static_ring<T, N>::begin() const noexcept
+{
+	return const_iterator(m_front_idx, this);
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::iterator sg14::static_ring<T, N>::end() noexcept
+{
+	return iterator(m_front_idx + m_size, this);
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_iterator sg14::static_ring<T, N>::end() const noexcept
+{
+	return const_iterator(m_front_idx + m_size, this);
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_iterator sg14::static_ring<T, N>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::reverse_iterator sg14::static_ring<T, N>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reverse_iterator sg14::static_ring<T, N>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reverse_iterator sg14::static_ring<T, N>::crbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_iterator sg14::static_ring<T, N>::cend() const noexcept
+{
+	return end();
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::reverse_iterator sg14::static_ring<T, N>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reverse_iterator sg14::static_ring<T, N>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reverse_iterator sg14::static_ring<T, N>::crend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename T, std::size_t N>
+void sg14::static_ring<T, N>::push_back(const T& value)
+{
+	emplace_back(value);
+}
+
+template<typename T, std::size_t N>
+void sg14::static_ring<T, N>::push_back(T&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename T, std::size_t N>
+template<class... FromType>
+typename sg14::static_ring<T, N>::reference sg14::static_ring<T, N>::emplace_back(FromType&&... from_value)
+{
+	if (full())
+	{
+		// The arguments may refer to the front element, so build the new
+		// element before destroying the one it replaces.
+		T value(std::forward<FromType>(from_value)...);
+		destroy_front();
+		T* p = ::new (storage(m_front_idx + m_size)) T(std::move(value));
+		++m_size;
+		return *p;
+	}
+	T* p = ::new (storage(m_front_idx + m_size)) T(std::forward<FromType>(from_value)...);
+	++m_size;
+	return *p;
+}
+
+template<typename T, std::size_t N>
+T sg14::static_ring<T, N>::pop_front()
+{
+	assert(m_size != 0);
+	T value(std::move(front()));
+	destroy_front();
+	return value;
+}
+
+template<typename T, std::size_t N>
+void sg14::static_ring<T, N>::clear() noexcept
+{
+	while (m_size != 0)
+	{
+		destroy_front();
+	}
+	m_front_idx = 0;
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::reference sg14::static_ring<T, N>::at(size_type i) noexcept
+{
+	return *slot(i);
+}
+
+template<typename T, std::size_t N>
+typename sg14::static_ring<T, N>::const_reference sg14::static_ring<T, N>::at(size_type i) const noexcept
+{
+	return *slot(i);
+}
+
+template<typename T, std::size_t N>
+void* sg14::static_ring<T, N>::storage(size_type i) noexcept
+{
+	return static_cast<void*>(&m_storage[i % N]);
+}
+
+// The element was created by placement new into the storage, so under C++17
+// a pointer to it must be laundered from the storage's address.
+template<typename T, std::size_t N>
+T* sg14::static_ring<T, N>::slot(size_type i) noexcept
+{
+#if defined(__cpp_lib_launder)
+	return std::launder(reinterpret_cast<T*>(&m_storage[i % N]));
+#else
+	return reinterpret_cast<T*>(&m_storage[i % N]);
+#endif
+}
+
+template<typename T, std::size_t N>
+const T* sg14::static_ring<T, N>::slot(size_type i) const noexcept
+{
+#if defined(__cpp_lib_launder)
+	return std::launder(reinterpret_cast<const T*>(&m_storage[i % N]));
+#else
+	return reinterpret_cast<const T*>(&m_storage[i % N]);
+#endif
+}
+
+template<typename T, std::size_t N>
+void sg14::static_ring<T, N>::destroy_front() noexcept
+{
+	slot(m_front_idx)->~T();
+	m_front_idx = (m_front_idx + 1) % N;
+	--m_size;
+}
+
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::spsc_ring_span<T, Popper>::spsc_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
+	: m_data(&*begin)
+	, m_capacity(end - begin)
+	, m_popper(std::move(p))
+	, m_head(0)
+	, m_cached_tail(0)
+	, m_tail(0)
+	, m_cached_head(0)
+{}
+
+template<typename T, class Popper>
+bool sg14::spsc_ring_span<T, Popper>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename T, class Popper>
+bool sg14::spsc_ring_span<T, Popper>::full() const noexcept
+{
+	return size() == m_capacity;
+}
+
+template<typename T, class Popper>
+typename sg14::spsc_ring_span<T, Popper>::size_type sg14::spsc_ring_span<T, Popper>::size() const noexcept
+{
+	return distance(m_head.load(std::memory_order_acquire), m_tail.load(std::memory_order_acquire));
+}
+
+template<typename T, class Popper>
+typename sg14::spsc_ring_span<T, Popper>::size_type sg14::spsc_ring_span<T, Popper>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+bool sg14::spsc_ring_span<T, Popper>::try_push(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value)
+{
+	return push_with([&](T& slot) { slot = value; });
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+bool sg14::spsc_ring_span<T, Popper>::try_push(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	return push_with([&](T& slot) { slot = std::move(value); });
+}
+
+template<typename T, class Popper>
+template<class... FromType>
+bool sg14::spsc_ring_span<T, Popper>::try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value)
+{
+	return push_with([&](T& slot) { slot = T(std::forward<FromType>(from_value)...); });
+}
+
+template<typename T, class Popper>
+bool sg14::spsc_ring_span<T, Popper>::try_pop()
+{
+	auto head = m_head.load(std::memory_order_relaxed);
+	if (head == m_cached_tail)
+	{
+		m_cached_tail = m_tail.load(std::memory_order_acquire);
+		if (head == m_cached_tail)
+		{
+			return false;
+		}
+	}
+	m_popper(m_data[wrap(head)]);
+	m_head.store(next(head), std::memory_order_release);
+	return true;
+}
+
+template<typename T, class Popper>
+template<class U>
+bool sg14::spsc_ring_span<T, Popper>::try_pop(U& to_value)
+{
+	auto head = m_head.load(std::memory_order_relaxed);
+	if (head == m_cached_tail)
+	{
+		m_cached_tail = m_tail.load(std::memory_order_acquire);
+		if (head == m_cached_tail)
+		{
+			return false;
+		}
+	}
+	to_value = m_popper(m_data[wrap(head)]);
+	m_head.store(next(head), std::memory_order_release);
+	return true;
+}
+
+template<typename T, class Popper>
+typename sg14::spsc_ring_span<T, Popper>::size_type sg14::spsc_ring_span<T, Popper>::wrap(size_type idx) const noexcept
+{
+	return idx < m_capacity ? idx : idx - m_capacity;
+}
+
+template<typename T, class Popper>
+typename sg14::spsc_ring_span<T, Popper>::size_type sg14::spsc_ring_span<T, Popper>::next(size_type counter) const noexcept
+{
+	return counter + 1 == 2 * m_capacity ? 0 : counter + 1;
+}
+
+template<typename T, class Popper>
+typename sg14::spsc_ring_span<T, Popper>::size_type sg14::spsc_ring_span<T, Popper>::distance(size_type from, size_type to) const noexcept
+{
+	return to >= from ? to - from : to + 2 * m_capacity - from;
+}
+
+template<typename T, class Popper>
+template<class Assign>
+bool sg14::spsc_ring_span<T, Popper>::push_with(Assign&& assign)
+{
+	auto tail = m_tail.load(std::memory_order_relaxed);
+	if (distance(m_cached_head, tail) == m_capacity)
+	{
+		m_cached_head = m_head.load(std::memory_order_acquire);
+		if (distance(m_cached_head, tail) == m_capacity)
+		{
+			return false;
+		}
+	}
+	assign(m_data[wrap(tail)]);
+	m_tail.store(next(tail), std::memory_order_release);
+	return true;
+}
+
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::mpmc_ring_span<T, Popper>::mpmc_ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
+	: m_cells(&*begin)
+	, m_capacity(end - begin)
+	, m_popper(std::move(p))
+	, m_push_pos(0)
+	, m_pop_pos(0)
+{
+	assert(m_capacity > 0);
+	for (size_type i = 0; i != m_capacity; ++i)
+	{
+		m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+template<typename T, class Popper>
+bool sg14::mpmc_ring_span<T, Popper>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename T, class Popper>
+typename sg14::mpmc_ring_span<T, Popper>::size_type sg14::mpmc_ring_span<T, Popper>::size() const noexcept
+{
+	auto pop_pos = m_pop_pos.load(std::memory_order_acquire);
+	auto push_pos = m_push_pos.load(std::memory_order_acquire);
+	return push_pos > pop_pos ? push_pos - pop_pos : 0;
+}
+
+template<typename T, class Popper>
+typename sg14::mpmc_ring_span<T, Popper>::size_type sg14::mpmc_ring_span<T, Popper>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+bool sg14::mpmc_ring_span<T, Popper>::try_push(const T& value) noexcept(std::is_nothrow_copy_constructible<T>::value)
+{
+	return try_emplace(value);
+}
+
+template<typename T, class Popper>
+template<bool b, typename>
+bool sg14::mpmc_ring_span<T, Popper>::try_push(T&& value) noexcept
+{
+	cell_type* cell = claim_for_push();
+	if (cell == nullptr)
+	{
+		return false;
+	}
+	cell->value = std::move(value);
+	cell->sequence.store(cell->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T, class Popper>
+template<class... FromType>
+bool sg14::mpmc_ring_span<T, Popper>::try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value)
+{
+	// Construct before claiming a cell, so that a throwing constructor
+	// leaves the queue untouched.
+	T value(std::forward<FromType>(from_value)...);
+	cell_type* cell = claim_for_push();
+	if (cell == nullptr)
+	{
+		return false;
+	}
+	cell->value = std::move(value);
+	cell->sequence.store(cell->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T, class Popper>
+bool sg14::mpmc_ring_span<T, Popper>::try_pop()
+{
+	cell_type* cell = claim_for_pop();
+	if (cell == nullptr)
+	{
+		return false;
+	}
+	pop_release release{cell, m_capacity};
+	m_popper(cell->value);
+	return true;
+}
+
+template<typename T, class Popper>
+template<class U>
+bool sg14::mpmc_ring_span<T, Popper>::try_pop(U& to_value)
+{
+	cell_type* cell = claim_for_pop();
+	if (cell == nullptr)
+	{
+		return false;
+	}
+	pop_release release{cell, m_capacity};
+	to_value = m_popper(cell->value);
+	return true;
+}
+
+template<typename T, class Popper>
+typename sg14::mpmc_ring_span<T, Popper>::cell_type* sg14::mpmc_ring_span<T, Popper>::claim_for_push() noexcept
+{
+	auto pos = m_push_pos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		cell_type* cell = &m_cells[pos % m_capacity];
+		auto seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+		if (diff == 0)
+		{
+			if (m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				return cell;
+			}
+		}
+		else if (diff < 0)
+		{
+			return nullptr;
+		}
+		else
+		{
+			pos = m_push_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T, class Popper>
+typename sg14::mpmc_ring_span<T, Popper>::cell_type* sg14::mpmc_ring_span<T, Popper>::claim_for_pop() noexcept
+{
+	auto pos = m_pop_pos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		cell_type* cell = &m_cells[pos % m_capacity];
+		auto seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+		if (diff == 0)
+		{
+			if (m_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				return cell;
+			}
+		}
+		else if (diff < 0)
+		{
+			return nullptr;
+		}
+		else
+		{
+			pos = m_pop_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template <typename Ring, bool is_const>
+sg14::ring_iterator<Ring, is_const>::operator sg14::ring_iterator<Ring, true>() const noexcept
+{
+	return sg14::ring_iterator<Ring, true>(m_idx, m_rv);
+}
+
+template <typename Ring, bool is_const>
+template<bool C>
+bool sg14::ring_iterator<Ring, is_const>::operator==(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+{
+	return (m_idx == rhs.m_idx) && (m_rv == rhs.m_rv);
+}
+
+template <typename Ring, bool is_const>
+template<bool C>
+bool sg14::ring_iterator<Ring, is_const>::operator!=(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+{
+	return !(*this == rhs);
+}
+
+template <typename Ring, bool is_const>
+template<bool C>
+bool sg14::ring_iterator<Ring, is_const>::operator<(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+{
+	return (m_idx < rhs.m_idx) && (m_rv == rhs.m_rv);
+}
+
+template <typename Ring, bool is_const>
+template<bool C>
+bool sg14::ring_iterator<Ring, is_const>::operator<=(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
+{
+	return !(rhs < *this);
+}
+
+template <typename Ring, bool is_const>
 template<bool C>
 bool sg14::ring_iterator<Ring, is_const>::operator>(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
 {
@@ -523,6 +1784,12 @@ namespace sg14
 		a.swap(b);
 	}
 
+	template<typename T, class Popper>
+	void swap(pow2_ring_span<T, Popper>& a, pow2_ring_span<T, Popper>& b) noexcept
+	{
+		a.swap(b);
+	}
+
 	template <typename Ring, bool C>
 	ring_iterator<Ring, C> operator+(ring_iterator<Ring, C> it, std::ptrdiff_t i) noexcept
 	{
@@ -26,6 +26,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -57,15 +65,108 @@ inline void reserve_if_possible(Ctr& ctr, const SizeType& n)
     slot_map_detail::reserve_if_possible(ctr, n, priority_tag<1>{});
 }
 
-} // namespace slot_map_detail
+// Pops the elements appended to a container past original_size, unless
+// dismissed. Used to undo a partially-completed bulk insert.
+template<class Ctr>
+struct append_guard {
+    Ctr *ctr;
+    typename Ctr::size_type original_size;
 
-template<
-    class T,
-    class Key = std::pair<unsigned, unsigned>,
-    template<class...> class Container = std::vector
->
-class slot_map
+    ~append_guard() {
+        if (ctr != nullptr) {
+            while (ctr->size() != original_size) {
+                ctr->pop_back();
+            }
+        }
+    }
+};
+
+template<class Ctr, class It>
+inline void reserve_for_range(Ctr&, It, It, std::input_iterator_tag) {}
+
+template<class Ctr, class It>
+inline void reserve_for_range(Ctr& ctr, It first, It last, std::forward_iterator_tag)
+{
+    slot_map_detail::reserve_if_possible(ctr, ctr.size() + static_cast<typename Ctr::size_type>(std::distance(first, last)));
+}
+
+template<class It, class Tag>
+using has_iterator_category = std::is_convertible<typename std::iterator_traits<It>::iterator_category, Tag>;
+
+// Container<T> where it has random access, and std::vector<T> otherwise,
+// for scratch arrays that have to be sorted.
+template<template<class...> class Container, class T>
+using random_access_container = typename std::conditional<
+    has_iterator_category<typename Container<T>::iterator, std::random_access_iterator_tag>::value,
+    Container<T>, std::vector<T>
+>::type;
+
+// Indexes into ctr in O(1): through its own iterators where they have
+// random access, and otherwise through a table of them.
+template<class Ctr, bool = has_iterator_category<typename Ctr::iterator, std::random_access_iterator_tag>::value>
+class index_view {
+public:
+    explicit index_view(Ctr& ctr) : first_(ctr.begin()) {}
+    typename Ctr::reference operator[](std::size_t i) const { return first_[i]; }
+private:
+    typename Ctr::iterator first_;
+};
+
+template<class Ctr>
+class index_view<Ctr, false> {
+public:
+    explicit index_view(Ctr& ctr) {
+        slot_map_detail::reserve_if_possible(iters_, ctr.size());
+        for (auto it = ctr.begin(); it != ctr.end(); ++it) {
+            iters_.push_back(it);
+        }
+    }
+    typename Ctr::reference operator[](std::size_t i) const { return *iters_[i]; }
+private:
+    std::vector<typename Ctr::iterator> iters_;
+};
+
+inline void prefetch(const void *p)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// A contiguous run of one column of a basic_slot_map_soa.
+template<class T>
+class column_span {
+public:
+    using element_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+
+    constexpr column_span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+    constexpr T& operator[](size_type i) const noexcept { return data_[i]; }
+
+private:
+    T *data_;
+    size_type size_;
+};
+
+// The slots, reverse map and free list shared by slot_map and
+// basic_slot_map_soa. The derived class keeps its values in containers of
+// exactly reverse_map_.size() entries each, in the same order, and moves
+// and pops them itself; every change to a slot or to the free list is made
+// here, so that the two maps cannot drift apart.
+//
+template<class Key, template<class...> class Container>
+class slot_table
 {
+protected:
 #if __cplusplus >= 201703L
     static constexpr auto get_index(const Key& k) { const auto& [idx, gen] = k; return idx; }
     static constexpr auto get_generation(const Key& k) { const auto& [idx, gen] = k; return gen; }
@@ -78,14 +179,229 @@ class slot_map
     static constexpr void increment_generation(Key& k) { using std::get; ++get<1>(k); }
 #endif
 
+    using key_index_type = decltype(slot_table::get_index(std::declval<Key>()));
+    using key_generation_type = decltype(slot_table::get_generation(std::declval<Key>()));
     using slot_iterator = typename Container<Key>::iterator;
+    using size_type = typename Container<key_index_type>::size_type;
+
+    // The position of the values of key, or reverse_map_.size() if the
+    // generation check fails.
+    constexpr size_type value_index_of(const Key& key) const {
+        auto slot_index = get_index(key);
+        if (slot_index >= slots_.size()) {
+            return reverse_map_.size();
+        }
+        auto slot_iter = std::next(slots_.begin(), slot_index);
+        if (get_generation(*slot_iter) != get_generation(key)) {
+            return reverse_map_.size();
+        }
+        return static_cast<size_type>(get_index(*slot_iter));
+    }
+
+    // The key of the values at pos.
+    constexpr Key key_at(size_type pos) const {
+        auto slot_index = *std::next(reverse_map_.begin(), pos);
+        Key result = *std::next(slots_.begin(), slot_index);
+        set_index(result, slot_index);
+        return result;
+    }
+
+    constexpr void reserve_slots(size_type n) {
+        slot_map_detail::reserve_if_possible(slots_, n);
+        key_index_type original_num_slots = static_cast<key_index_type>(slots_.size());
+        if (original_num_slots < n) {
+            slots_.emplace_back(Key{next_available_slot_index_, key_generation_type{}});
+            key_index_type last_new_slot = original_num_slots;
+            --n;
+            while (last_new_slot != n) {
+                slots_.emplace_back(Key{last_new_slot, key_generation_type{}});
+                ++last_new_slot;
+            }
+            next_available_slot_index_ = last_new_slot;
+        }
+    }
+
+    // Gives a slot to the values just appended at value_pos, from the free
+    // list if it has one, and returns their key. If growing slots_ or
+    // reverse_map_ throws, nothing has changed.
+    constexpr Key push_slot(size_type value_pos) {
+        reverse_map_.emplace_back(next_available_slot_index_);
+        if (next_available_slot_index_ == slots_.size()) {
+            append_guard<Container<key_index_type>> guard{&reverse_map_, value_pos};
+            auto idx = next_available_slot_index_; ++idx;
+            slots_.emplace_back(Key{idx, key_generation_type{}});  // make a new slot
+            guard.ctr = nullptr;
+            last_available_slot_index_ = idx;
+        }
+        auto slot_iter = std::next(slots_.begin(), next_available_slot_index_);
+        if (next_available_slot_index_ == last_available_slot_index_) {
+            next_available_slot_index_ = static_cast<key_index_type>(slots_.size());
+            last_available_slot_index_ = next_available_slot_index_;
+        } else {
+            next_available_slot_index_ = get_index(*slot_iter);
+        }
+        set_index(*slot_iter, value_pos);
+        Key result = *slot_iter;
+        set_index(result, std::distance(slots_.begin(), slot_iter));
+        return result;
+    }
+
+    // Gives a slot to each of the values from reverse_map_.size() up to
+    // new_size, as if by push_slot(), which have already been appended.
+    // Growing slots_ and reverse_map_ is the only step that can throw, so it
+    // comes first, while values_guard and guards of its own can still undo
+    // everything; the free list is consumed only after that. Keys are written
+    // to keys_out last, once the maps are consistent again.
+    template<class ValuesGuard, class OutputIterator>
+    constexpr OutputIterator push_slots(size_type new_size, ValuesGuard& values_guard, OutputIterator keys_out) {
+        const size_type original_size = reverse_map_.size();
+        const size_type free_slots = static_cast<size_type>(slots_.size() - original_size);
+        const auto old_slot_count = static_cast<key_index_type>(slots_.size());
+        slot_map_detail::reserve_if_possible(reverse_map_, new_size);
+        if (new_size - original_size > free_slots) {
+            slot_map_detail::reserve_if_possible(slots_, slots_.size() + (new_size - original_size - free_slots));
+        }
+        append_guard<Container<key_index_type>> reverse_map_guard{&reverse_map_, reverse_map_.size()};
+        append_guard<Container<Key>> slots_guard{&slots_, slots_.size()};
+        size_type value_pos = original_size;
+        key_index_type slot_index = next_available_slot_index_;
+        for (; value_pos != new_size && slot_index != old_slot_count; ++value_pos) {
+            reverse_map_.emplace_back(slot_index);
+            slot_index = (slot_index == last_available_slot_index_) ? old_slot_count : get_index(*std::next(slots_.begin(), slot_index));
+        }
+        const size_type reused_end = value_pos;
+        // The free list is exhausted: append fresh slots, after which it is empty again.
+        for (; value_pos != new_size; ++value_pos) {
+            reverse_map_.emplace_back(static_cast<key_index_type>(slots_.size()));
+            slots_.emplace_back(Key{static_cast<key_index_type>(value_pos), key_generation_type{}});
+        }
+        slots_guard.ctr = nullptr;
+        reverse_map_guard.ctr = nullptr;
+        values_guard.ctr = nullptr;
+
+        auto reverse_map_iter = std::next(reverse_map_.begin(), original_size);
+        for (value_pos = original_size; value_pos != reused_end; ++value_pos, ++reverse_map_iter) {
+            set_index(*std::next(slots_.begin(), *reverse_map_iter), value_pos);
+        }
+        if (slot_index == old_slot_count) {
+            next_available_slot_index_ = static_cast<key_index_type>(slots_.size());
+            last_available_slot_index_ = next_available_slot_index_;
+        } else {
+            next_available_slot_index_ = slot_index;
+        }
+        for (value_pos = original_size; value_pos != new_size; ++value_pos) {
+            *keys_out = key_at(value_pos);
+            ++keys_out;
+        }
+        return keys_out;
+    }
+
+    // Expires the key of the values at pos and appends its slot to the free
+    // list. The caller has already moved the values at the back, if pos is
+    // not the back, into pos, and popped the back; this does the same with
+    // reverse_map_ and repoints the moved values' slot.
+    constexpr void release_slot(size_type pos) {
+        auto slot_index = *std::next(reverse_map_.begin(), pos);
+        const size_type back = reverse_map_.size() - 1;
+        if (pos != back) {
+            auto back_slot_index = *std::next(reverse_map_.begin(), back);
+            set_index(*std::next(slots_.begin(), back_slot_index), pos);
+            *std::next(reverse_map_.begin(), pos) = back_slot_index;
+        }
+        reverse_map_.pop_back();
+        if (next_available_slot_index_ == slots_.size()) {
+            next_available_slot_index_ = slot_index;
+            last_available_slot_index_ = slot_index;
+        } else {
+            auto last_slot_iter = std::next(slots_.begin(), last_available_slot_index_);
+            set_index(*last_slot_iter, slot_index);
+            last_available_slot_index_ = slot_index;
+        }
+        increment_generation(*std::next(slots_.begin(), slot_index));
+    }
+
+    // Expires the keys of the values in [first_index, last_index) and appends
+    // their slots to the free list, last value first, as repeated erase()
+    // from the back would.
+    constexpr void release_slots(size_type first_index, size_type last_index) {
+        auto reverse_map_first = std::next(reverse_map_.begin(), first_index);
+        auto reverse_map_iter = std::next(reverse_map_first, last_index - first_index);
+        key_index_type first_freed = *std::prev(reverse_map_iter);
+        slot_iterator prev_slot_iter = slots_.end();
+        while (reverse_map_iter != reverse_map_first) {
+            --reverse_map_iter;
+            auto slot_iter = std::next(slots_.begin(), *reverse_map_iter);
+            increment_generation(*slot_iter);
+            if (prev_slot_iter != slots_.end()) {
+                set_index(*prev_slot_iter, *reverse_map_iter);
+            }
+            prev_slot_iter = slot_iter;
+        }
+        key_index_type last_freed = *reverse_map_first;
+        if (next_available_slot_index_ == slots_.size()) {
+            next_available_slot_index_ = first_freed;
+        } else {
+            auto last_slot_iter = std::next(slots_.begin(), last_available_slot_index_);
+            set_index(*last_slot_iter, first_freed);
+        }
+        last_available_slot_index_ = last_freed;
+    }
+
+    constexpr void clear_slots() {
+        // This resets the generation counters, which "undefined-behavior-izes" at() and find() for the old keys.
+        slots_.clear();
+        reverse_map_.clear();
+        next_available_slot_index_ = key_index_type{};
+        last_available_slot_index_ = key_index_type{};
+    }
+
+    constexpr void swap_slots(slot_table& rhs) {
+        using std::swap;
+        swap(slots_, rhs.slots_);
+        swap(reverse_map_, rhs.reverse_map_);
+        swap(next_available_slot_index_, rhs.next_available_slot_index_);
+        swap(last_available_slot_index_, rhs.last_available_slot_index_);
+    }
+
+    Container<Key> slots_;  // high_water_mark() entries
+    Container<key_index_type> reverse_map_;  // exactly size() entries
+    key_index_type next_available_slot_index_{};
+    key_index_type last_available_slot_index_{};
+
+    // Class invariant:
+    // Either next_available_slot_index_ == last_available_slot_index_ == slots_.size(),
+    // or else 0 <= next_available_slot_index_ < slots_.size() and the "key" of that slot
+    // entry points to the subsequent available slot, and so on, until reaching
+    // last_available_slot_index_ (which might equal next_available_slot_index_ if there
+    // is only one available slot at the moment).
+};
+
+} // namespace slot_map_detail
+
+template<
+    class T,
+    class Key = std::pair<unsigned, unsigned>,
+    template<class...> class Container = std::vector
+>
+class slot_map : private slot_map_detail::slot_table<Key, Container>
+{
+    using table_type = slot_map_detail::slot_table<Key, Container>;
+    using table_type::get_index;
+    using table_type::get_generation;
+    using table_type::set_index;
+    using table_type::increment_generation;
+    using table_type::slots_;
+    using table_type::reverse_map_;
+    using table_type::next_available_slot_index_;
+    using table_type::last_available_slot_index_;
+    using slot_iterator = typename table_type::slot_iterator;
 
 public:
     using key_type = Key;
     using mapped_type = T;
 
-    using key_index_type = decltype(slot_map::get_index(std::declval<Key>()));
-    using key_generation_type = decltype(slot_map::get_generation(std::declval<Key>()));
+    using key_index_type = typename table_type::key_index_type;
+    using key_generation_type = typename table_type::key_generation_type;
 
     using container_type = Container<mapped_type>;
     using reference = typename container_type::reference;
@@ -178,6 +494,59 @@ public:
         return value_iter;
     }
 
+    // find_many() looks up each key in [first, last), as if by find(), and
+    // writes a pointer to its value, or nullptr if the check fails, to
+    // ptrs_out. for_each_key() calls f(value) for each key that passes the
+    // check, in order, and returns how many did.
+    // When the keys are read through forward iterators and the adapted
+    // containers are random-access, the slot of each key is prefetched
+    // several keys ahead, and then its value, so that the cache misses of
+    // consecutive lookups overlap instead of forming one dependent chain.
+    // O(n) time complexity in the number of keys, and O(1) space complexity.
+    //
+    template<class InputIterator, class OutputIterator>
+    constexpr OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator ptrs_out) {
+        auto values = values_.begin();
+        this->visit_keys(first, last, [&](size_type value_index) {
+            *ptrs_out = (value_index == values_.size()) ? nullptr : std::addressof(*std::next(values, value_index));
+            ++ptrs_out;
+        });
+        return ptrs_out;
+    }
+    template<class InputIterator, class OutputIterator>
+    constexpr OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator ptrs_out) const {
+        auto values = values_.begin();
+        this->visit_keys(first, last, [&](size_type value_index) {
+            *ptrs_out = (value_index == values_.size()) ? nullptr : std::addressof(*std::next(values, value_index));
+            ++ptrs_out;
+        });
+        return ptrs_out;
+    }
+    template<class InputIterator, class F>
+    constexpr size_type for_each_key(InputIterator first, InputIterator last, F f) {
+        auto values = values_.begin();
+        size_type found = 0;
+        this->visit_keys(first, last, [&](size_type value_index) {
+            if (value_index != values_.size()) {
+                f(*std::next(values, value_index));
+                ++found;
+            }
+        });
+        return found;
+    }
+    template<class InputIterator, class F>
+    constexpr size_type for_each_key(InputIterator first, InputIterator last, F f) const {
+        auto values = values_.begin();
+        size_type found = 0;
+        this->visit_keys(first, last, [&](size_type value_index) {
+            if (value_index != values_.size()) {
+                f(*std::next(values, value_index));
+                ++found;
+            }
+        });
+        return found;
+    }
+
     // All begin() and end() variations have O(1) time and space complexity.
     //
     constexpr iterator begin()                         { return values_.begin(); }
@@ -218,20 +587,7 @@ public:
     // These are beneficial as allocating more slots than values will cause the
     // generation counter increases to be more evenly distributed across the slots.
     //
-    constexpr void reserve_slots(size_type n) {
-        slot_map_detail::reserve_if_possible(slots_, n);
-        key_index_type original_num_slots = static_cast<key_index_type>(slots_.size());
-        if (original_num_slots < n) {
-            slots_.emplace_back(key_type{next_available_slot_index_, key_generation_type{}});
-            key_index_type last_new_slot = original_num_slots;
-            --n;
-            while (last_new_slot != n) {
-                slots_.emplace_back(key_type{last_new_slot, key_generation_type{}});
-                ++last_new_slot;
-            }
-            next_available_slot_index_ = last_new_slot;
-        }
-    }
+    constexpr void reserve_slots(size_type n) { table_type::reserve_slots(n); }
     constexpr size_type slot_count() const { return slots_.size(); }
 
     // These operations have O(1) time and space complexity.
@@ -244,27 +600,50 @@ public:
     template<class... Args> constexpr key_type emplace(Args&&... args) {
         auto value_pos = values_.size();
         values_.emplace_back(std::forward<Args>(args)...);
-        reverse_map_.emplace_back(next_available_slot_index_);
-        if (next_available_slot_index_ == slots_.size()) {
-            auto idx = next_available_slot_index_; ++idx;
-            slots_.emplace_back(key_type{idx, key_generation_type{}});  // make a new slot
-            last_available_slot_index_ = idx;
+        slot_map_detail::append_guard<Container<mapped_type>> guard{&values_, value_pos};
+        key_type result = this->push_slot(value_pos);
+        guard.ctr = nullptr;
+        return result;
+    }
+
+    // The bulk insert() and insert_n() functions append all the values first,
+    // then give each one a slot: the free list is consumed in order, and once
+    // it is exhausted new slots are appended. The key of each value is written
+    // to keys_out, in insertion order, and the advanced output iterator is
+    // returned. Containers supporting reserve() are grown at most once.
+    // If constructing a value or growing the slot bookkeeping throws, the
+    // slot_map is left unchanged. If writing to keys_out throws, every value
+    // has already been inserted.
+    // O(n) time complexity in the number of values inserted.
+    //
+    template<class InputIterator, class OutputIterator>
+    constexpr OutputIterator insert(InputIterator first, InputIterator last, OutputIterator keys_out) {
+        slot_map_detail::reserve_for_range(values_, first, last, typename std::iterator_traits<InputIterator>::iterator_category{});
+        slot_map_detail::append_guard<Container<mapped_type>> guard{&values_, values_.size()};
+        for (; first != last; ++first) {
+            values_.emplace_back(*first);
         }
-        auto slot_iter = std::next(slots_.begin(), next_available_slot_index_);
-        if (next_available_slot_index_ == last_available_slot_index_) {
-            next_available_slot_index_ = static_cast<key_index_type>(slots_.size());
-            last_available_slot_index_ = next_available_slot_index_;
-        } else {
-            next_available_slot_index_ = this->get_index(*slot_iter);
+        return this->push_slots(values_.size(), guard, keys_out);
+    }
+
+    template<class OutputIterator>
+    constexpr OutputIterator insert_n(size_type n, const mapped_type& value, OutputIterator keys_out) {
+        // value might be one of our own values, which reserve() would move.
+        mapped_type copy(value);
+        slot_map_detail::reserve_if_possible(values_, values_.size() + n);
+        slot_map_detail::append_guard<Container<mapped_type>> guard{&values_, values_.size()};
+        for (size_type i = 0; i != n; ++i) {
+            values_.emplace_back(copy);
         }
-        this->set_index(*slot_iter, value_pos);
-        key_type result = *slot_iter;
-        this->set_index(result, std::distance(slots_.begin(), slot_iter));
-        return result;
+        return this->push_slots(values_.size(), guard, keys_out);
     }
 
     // Each erase() version has an O(1) time complexity per value
-    // and O(1) space complexity.
+    // and O(1) space complexity. The range version expires the keys of
+    // [first, last) and splices their slots onto the free list in one pass,
+    // then fills the hole with the last last - first values, in order. If
+    // fewer values than that follow the range, they end up in the same order
+    // that erasing [first, last) one value at a time from the back gives.
     //
     constexpr iterator erase(iterator pos) { return this->erase(const_iterator(pos)); }
     constexpr iterator erase(iterator first, iterator last) { return this->erase(const_iterator(first), const_iterator(last)); }
@@ -274,12 +653,11 @@ public:
     }
     constexpr iterator erase(const_iterator first, const_iterator last) {
         // Must use indexes, not iterators, because Container iterators might be invalidated by pop_back
-        auto first_index = std::distance(this->cbegin(), first);
-        auto last_index = std::distance(this->cbegin(), last);
-        while (last_index != first_index) {
-            --last_index;
-            auto iter = std::next(this->cbegin(), last_index);
-            this->erase(iter);
+        auto first_index = static_cast<size_type>(std::distance(this->cbegin(), first));
+        auto last_index = static_cast<size_type>(std::distance(this->cbegin(), last));
+        if (first_index != last_index) {
+            this->release_slots(first_index, last_index);
+            this->move_tail_into(first_index, last_index);
         }
         return std::next(this->begin(), first_index);
     }
@@ -292,28 +670,52 @@ public:
         return 1;
     }
 
+    // sort() and partition() reorder the values, and therefore iteration,
+    // without invalidating any key: values_ and reverse_map_ are permuted
+    // together and each slot is repointed at its value's new position.
+    // partition() returns an iterator to the first value for which pred
+    // is false. Neither is stable. mapped_type must be nothrow move
+    // constructible and assignable. Every step that can throw (comp, pred,
+    // and allocating the O(n) scratch arrays) comes before the slot_map is
+    // modified, so if anything throws the slot_map is unchanged.
+    // O(n log n) and O(n) time complexity respectively, plus O(n) moves,
+    // and O(n) space complexity.
+    //
+    template<class Compare = std::less<>>
+    void sort(Compare comp = Compare()) {
+        this->reorder([&](order_type& order, const values_view& values) {
+            std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return comp(static_cast<const mapped_type&>(values[a]), static_cast<const mapped_type&>(values[b]));
+            });
+        });
+    }
+    template<class Predicate>
+    iterator partition(Predicate pred) {
+        size_type count = 0;
+        this->reorder([&](order_type& order, const values_view& values) {
+            auto mid = std::partition(order.begin(), order.end(), [&](size_type i) {
+                return pred(static_cast<const mapped_type&>(values[i]));
+            });
+            count = static_cast<size_type>(mid - order.begin());
+        });
+        return std::next(this->begin(), count);
+    }
+
     // clear() has O(n) time complexity and O(1) space complexity.
     // It also has semantics differing from erase(begin(), end())
     // in that it also resets the generation counter of every slot
     // and rebuilds the free list.
     //
     constexpr void clear() {
-        // This resets the generation counters, which "undefined-behavior-izes" at() and find() for the old keys.
-        slots_.clear();
         values_.clear();
-        reverse_map_.clear();
-        next_available_slot_index_ = key_index_type{};
-        last_available_slot_index_ = key_index_type{};
+        this->clear_slots();
     }
 
     // swap is not mentioned in P0661r1 but it should be.
     constexpr void swap(slot_map& rhs) {
         using std::swap;
-        swap(slots_, rhs.slots_);
         swap(values_, rhs.values_);
-        swap(reverse_map_, rhs.reverse_map_);
-        swap(next_available_slot_index_, rhs.next_available_slot_index_);
-        swap(last_available_slot_index_, rhs.last_available_slot_index_);
+        this->swap_slots(rhs);
     }
 
 protected:
@@ -325,50 +727,176 @@ protected:
     constexpr const Container<mapped_type>&& c() const&& noexcept { return std::move(values_); }
 
 private:
+    using order_type = slot_map_detail::random_access_container<Container, size_type>;
+    using values_view = slot_map_detail::index_view<Container<mapped_type>>;
+
+    // Calls reorder(order, values), where order is [0, size()) and values
+    // gives indexed access to the values, to rearrange order so that
+    // order[i] is the position of the value that should move to position i;
+    // then applies that permutation to values_ and reverse_map_ together,
+    // and repoints the slots. order is a Container too, unless that lacks
+    // the random access sorting it needs, and values_ and reverse_map_ are
+    // indexed in place where they allow it.
+    template<class Reorder>
+    void reorder(Reorder reorder) {
+        static_assert(std::is_nothrow_move_constructible<mapped_type>::value && std::is_nothrow_move_assignable<mapped_type>::value,
+            "sort() and partition() need mapped_type's moves not to throw, or a throw part-way would leave keys pointing at the wrong values");
+        const size_type n = values_.size();
+        const values_view values(values_);
+        const slot_map_detail::index_view<Container<key_index_type>> reverse_map(reverse_map_);
+        order_type order;
+        slot_map_detail::reserve_if_possible(order, n);
+        for (size_type i = 0; i != n; ++i) {
+            order.emplace_back(i);
+        }
+        reorder(order, values);
+
+        // Follow each cycle of the permutation, so every value is moved
+        // once, plus once more per cycle. Placed positions are marked by
+        // order[i] == i.
+        const slot_map_detail::index_view<order_type> placed(order);
+        for (size_type start = 0; start != n; ++start) {
+            if (placed[start] == start) {
+                continue;
+            }
+            mapped_type displaced = std::move(values[start]);
+            key_index_type displaced_slot = reverse_map[start];
+            size_type dst = start;
+            for (size_type src = placed[dst]; src != start; src = placed[dst]) {
+                values[dst] = std::move(values[src]);
+                reverse_map[dst] = reverse_map[src];
+                placed[dst] = dst;
+                dst = src;
+            }
+            values[dst] = std::move(displaced);
+            reverse_map[dst] = displaced_slot;
+            placed[dst] = dst;
+        }
+        size_type i = 0;
+        for (auto it = reverse_map_.begin(); it != reverse_map_.end(); ++it, ++i) {
+            this->set_index(*std::next(slots_.begin(), *it), i);
+        }
+    }
+
+    // Calls visit(value_index_of(key)) for each key in [first, last),
+    // prefetching when that is cheap: see find_many().
+    template<class InputIterator, class Visit>
+    constexpr void visit_keys(InputIterator first, InputIterator last, Visit visit) const {
+        using can_prefetch = std::integral_constant<bool,
+            slot_map_detail::has_iterator_category<InputIterator, std::forward_iterator_tag>::value &&
+            slot_map_detail::has_iterator_category<typename Container<key_type>::const_iterator, std::random_access_iterator_tag>::value &&
+            slot_map_detail::has_iterator_category<const_iterator, std::random_access_iterator_tag>::value
+        >;
+        this->visit_keys(first, last, visit, can_prefetch{});
+    }
+    template<class InputIterator, class Visit>
+    constexpr void visit_keys(InputIterator first, InputIterator last, Visit& visit, std::false_type) const {
+        for (; first != last; ++first) {
+            visit(this->value_index_of(*first));
+        }
+    }
+    template<class ForwardIterator, class Visit>
+    constexpr void visit_keys(ForwardIterator first, ForwardIterator last, Visit& visit, std::true_type) const {
+        // Slots are prefetched lookahead keys ahead of values, and values
+        // lookahead keys ahead of the lookups, which is enough to cover a
+        // miss to memory at a few nanoseconds per lookup.
+        constexpr size_t lookahead = 8;
+        auto prefetch_slot = [&](const key_type& key) {
+            auto slot_index = get_index(key);
+            if (slot_index < slots_.size()) {
+                slot_map_detail::prefetch(std::addressof(*std::next(slots_.begin(), slot_index)));
+            }
+        };
+        auto prefetch_value = [&](const key_type& key) {
+            auto slot_index = get_index(key);
+            if (slot_index < slots_.size()) {
+                auto value_index = get_index(*std::next(slots_.begin(), slot_index));
+                if (value_index < values_.size()) {
+                    slot_map_detail::prefetch(std::addressof(*std::next(values_.begin(), value_index)));
+                }
+            }
+        };
+        ForwardIterator slot_ahead = first;
+        ForwardIterator value_ahead = first;
+        for (size_t lead = 0; lead != 2 * lookahead && slot_ahead != last; ++lead, ++slot_ahead) {
+            prefetch_slot(*slot_ahead);
+            if (lead >= lookahead) {
+                prefetch_value(*value_ahead);
+                ++value_ahead;
+            }
+        }
+        for (; first != last; ++first) {
+            if (slot_ahead != last) {
+                prefetch_slot(*slot_ahead);
+                ++slot_ahead;
+            }
+            if (value_ahead != last) {
+                prefetch_value(*value_ahead);
+                ++value_ahead;
+            }
+            visit(this->value_index_of(*first));
+        }
+    }
+
+    // Moves the last last_index - first_index values into the hole at
+    // first_index, in order, repoints their slots, and pops the now-unused
+    // entries off values_ and reverse_map_. If fewer values than that follow
+    // the hole, it is closed from the back one value at a time instead, so
+    // the result matches repeated single erases from the back.
+    constexpr void move_tail_into(size_type first_index, size_type last_index) {
+        const size_type count = last_index - first_index;
+        const size_type size = values_.size();
+        if (size - last_index < count) {
+            for (size_type value_index = last_index; value_index != first_index; ) {
+                --value_index;
+                const size_type back_index = values_.size() - 1;
+                if (value_index != back_index) {
+                    auto src_reverse = std::next(reverse_map_.begin(), back_index);
+                    *std::next(values_.begin(), value_index) = std::move(*std::next(values_.begin(), back_index));
+                    *std::next(reverse_map_.begin(), value_index) = *src_reverse;
+                    this->set_index(*std::next(slots_.begin(), *src_reverse), value_index);
+                }
+                values_.pop_back();
+                reverse_map_.pop_back();
+            }
+            return;
+        }
+        auto dst_value = std::next(values_.begin(), first_index);
+        auto dst_reverse = std::next(reverse_map_.begin(), first_index);
+        auto src_value = std::next(values_.begin(), size - count);
+        auto src_reverse = std::next(reverse_map_.begin(), size - count);
+        for (size_type value_index = first_index; src_value != values_.end(); ++value_index) {
+            *dst_value = std::move(*src_value);
+            *dst_reverse = *src_reverse;
+            this->set_index(*std::next(slots_.begin(), *src_reverse), value_index);
+            ++dst_value; ++dst_reverse; ++src_value; ++src_reverse;
+        }
+        for (size_type i = 0; i != count; ++i) {
+            values_.pop_back();
+            reverse_map_.pop_back();
+        }
+    }
+
     constexpr slot_iterator slot_iter_from_value_iter(const_iterator value_iter) {
         auto value_index = std::distance(const_iterator(values_.begin()), value_iter);
         auto slot_index = *std::next(reverse_map_.begin(), value_index);
         return std::next(slots_.begin(), slot_index);
     }
     constexpr iterator erase_slot_iter(slot_iterator slot_iter) {
-        auto slot_index = std::distance(slots_.begin(), slot_iter);
         auto value_index = get_index(*slot_iter);
         auto value_iter = std::next(values_.begin(), value_index);
         auto value_back_iter = std::prev(values_.end());
         if (value_iter != value_back_iter) {
-            auto slot_back_iter = slot_iter_from_value_iter(value_back_iter);
             *value_iter = std::move(*value_back_iter);
-            this->set_index(*slot_back_iter, value_index);
-            auto reverse_map_iter = std::next(reverse_map_.begin(), value_index);
-            *reverse_map_iter = static_cast<key_index_type>(std::distance(slots_.begin(), slot_back_iter));
         }
         values_.pop_back();
-        reverse_map_.pop_back();
-        // Expire this key.
-        if (next_available_slot_index_ == slots_.size()) {
-            next_available_slot_index_ = static_cast<key_index_type>(slot_index);
-            last_available_slot_index_ = static_cast<key_index_type>(slot_index);
-        } else {
-            auto last_slot_iter = std::next(slots_.begin(), last_available_slot_index_);
-            this->set_index(*last_slot_iter, slot_index);
-            last_available_slot_index_ = static_cast<key_index_type>(slot_index);
-        }
-        this->increment_generation(*slot_iter);
+        this->release_slot(value_index);
         return std::next(values_.begin(), value_index);
     }
 
-    Container<key_type> slots_;  // high_water_mark() entries
-    Container<key_index_type> reverse_map_;  // exactly size() entries
     Container<mapped_type> values_;  // exactly size() entries
-    key_index_type next_available_slot_index_{};
-    key_index_type last_available_slot_index_{};
 
-    // Class invariant:
-    // Either next_available_slot_index_ == last_available_slot_index_ == slots_.size(),
-    // or else 0 <= next_available_slot_index_ < slots_.size() and the "key" of that slot
-    // entry points to the subsequent available slot, and so on, until reaching
-    // last_available_slot_index_ (which might equal next_available_slot_index_ if there
-    // is only one available slot at the moment).
+    // Class invariant: as for slot_table, with values_ in reverse_map_ order.
 };
 
 template<class T, class Key, template<class...> class Container>
@@ -376,4 +904,194 @@ constexpr void swap(slot_map<T, Key, Container>& lhs, slot_map<T, Key, Container
     lhs.swap(rhs);
 }
 
+// basic_slot_map_soa stores one value per column, Ts..., for each key, with
+// each column in its own Container. Keys, slots and the free list are the
+// same slot_table as slot_map's, and erase() swaps-and-pops every column together,
+// so all columns stay in the same order and a loop over a single column
+// touches only that column's memory.
+//
+template<
+    class Key,
+    template<class...> class Container,
+    class... Ts
+>
+class basic_slot_map_soa : private slot_map_detail::slot_table<Key, Container>
+{
+    using table_type = slot_map_detail::slot_table<Key, Container>;
+    using table_type::get_index;
+    using table_type::slots_;
+    using table_type::reverse_map_;
+
+    static_assert(sizeof...(Ts) != 0, "basic_slot_map_soa needs at least one column");
+
+public:
+    using key_type = Key;
+    using key_index_type = typename table_type::key_index_type;
+    using key_generation_type = typename table_type::key_generation_type;
+    using size_type = typename table_type::size_type;
+
+    template<size_t I> using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+    template<size_t I> using column_container_type = Container<column_type<I>>;
+    template<size_t I> using column_span = slot_map_detail::column_span<column_type<I>>;
+    template<size_t I> using const_column_span = slot_map_detail::column_span<const column_type<I>>;
+
+    static constexpr size_t column_count = sizeof...(Ts);
+
+    constexpr basic_slot_map_soa() = default;
+    constexpr basic_slot_map_soa(const basic_slot_map_soa&) = default;
+    constexpr basic_slot_map_soa(basic_slot_map_soa&&) = default;
+    constexpr basic_slot_map_soa& operator=(const basic_slot_map_soa&) = default;
+    constexpr basic_slot_map_soa& operator=(basic_slot_map_soa&&) = default;
+    ~basic_slot_map_soa() = default;
+
+    // find() has generation counter checking. It returns the position of
+    // the key's values within every column, or size() if the check fails.
+    // O(1) time and space complexity.
+    //
+    constexpr size_type find(const key_type& key) const { return this->value_index_of(key); }
+    constexpr bool contains(const key_type& key) const { return this->find(key) != size(); }
+
+    // at<I>() has both generation counter checking and bounds checking,
+    // and throws if either check fails. get<I>() performs no checks.
+    // O(1) time and space complexity.
+    //
+    template<size_t I> constexpr column_type<I>& at(const key_type& key) {
+        auto pos = this->find(key);
+        if (pos == size()) {
+            SLOT_MAP_THROW_EXCEPTION(std::out_of_range, "at");
+        }
+        return *std::next(std::get<I>(columns_).begin(), pos);
+    }
+    template<size_t I> constexpr const column_type<I>& at(const key_type& key) const {
+        auto pos = this->find(key);
+        if (pos == size()) {
+            SLOT_MAP_THROW_EXCEPTION(std::out_of_range, "at");
+        }
+        return *std::next(std::get<I>(columns_).begin(), pos);
+    }
+    template<size_t I> constexpr column_type<I>& get(const key_type& key) {
+        auto slot_iter = std::next(slots_.begin(), get_index(key));
+        return *std::next(std::get<I>(columns_).begin(), get_index(*slot_iter));
+    }
+    template<size_t I> constexpr const column_type<I>& get(const key_type& key) const {
+        auto slot_iter = std::next(slots_.begin(), get_index(key));
+        return *std::next(std::get<I>(columns_).begin(), get_index(*slot_iter));
+    }
+
+    // The key whose values are at position pos in every column.
+    // O(1) time and space complexity.
+    //
+    constexpr key_type key_at(size_type pos) const { return table_type::key_at(pos); }
+
+    // column<I>() views the whole of column I, in the same order as every
+    // other column, for tight loops over one field. It is available only
+    // when Container provides data(), i.e. when it is contiguous.
+    // O(1) time and space complexity.
+    //
+    template<size_t I, class C = column_container_type<I>, class = decltype(std::declval<C&>().data())>
+    constexpr column_span<I> column() {
+        auto& c = std::get<I>(columns_);
+        return column_span<I>(c.data(), c.size());
+    }
+    template<size_t I, class C = column_container_type<I>, class = decltype(std::declval<const C&>().data())>
+    constexpr const_column_span<I> column() const {
+        const auto& c = std::get<I>(columns_);
+        return const_column_span<I>(c.data(), c.size());
+    }
+
+    constexpr bool empty() const                      { return reverse_map_.size() == 0; }
+    constexpr size_type size() const                  { return reverse_map_.size(); }
+
+    constexpr void reserve(size_type n) {
+        this->for_each_column([n](auto& c) { slot_map_detail::reserve_if_possible(c, n); });
+        slot_map_detail::reserve_if_possible(reverse_map_, n);
+        reserve_slots(n);
+    }
+
+    constexpr void reserve_slots(size_type n) { table_type::reserve_slots(n); }
+    constexpr size_type slot_count() const { return slots_.size(); }
+
+    // insert() takes one value per column. If constructing any of them
+    // throws, the slot_map is left unchanged.
+    // O(1) time and space complexity, plus any reallocation of the columns.
+    //
+    template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts)>>
+    constexpr key_type insert(Us&&... values) {
+        return this->append_columns(std::integral_constant<size_t, 0>{}, std::forward<Us>(values)...);
+    }
+
+    // erase() moves the last values of every column into the erased
+    // position, so it invalidates the position of one other key.
+    // O(1) time and space complexity.
+    //
+    constexpr size_type erase(const key_type& key) {
+        auto pos = this->find(key);
+        if (pos == size()) {
+            return 0;
+        }
+        this->erase_at(pos);
+        return 1;
+    }
+    constexpr void erase_at(size_type pos) {
+        const size_type back = size() - 1;
+        if (pos != back) {
+            this->for_each_column([pos, back](auto& c) {
+                *std::next(c.begin(), pos) = std::move(*std::next(c.begin(), back));
+            });
+        }
+        this->for_each_column([](auto& c) { c.pop_back(); });
+        this->release_slot(pos);
+    }
+
+    // clear() has the same semantics as slot_map::clear().
+    //
+    constexpr void clear() {
+        this->for_each_column([](auto& c) { c.clear(); });
+        this->clear_slots();
+    }
+
+    constexpr void swap(basic_slot_map_soa& rhs) {
+        using std::swap;
+        swap(columns_, rhs.columns_);
+        this->swap_slots(rhs);
+    }
+
+private:
+    template<class F>
+    constexpr void for_each_column(F f) {
+        this->for_each_column(f, std::index_sequence_for<Ts...>{});
+    }
+    template<class F, size_t... Is>
+    constexpr void for_each_column(F& f, std::index_sequence<Is...>) {
+        (void)std::initializer_list<int>{(f(std::get<Is>(columns_)), 0)...};
+    }
+
+    // Appends one value to each column from I onwards and then gives them
+    // a slot, popping each column again if anything later throws.
+    template<size_t I, class U, class... Us>
+    constexpr key_type append_columns(std::integral_constant<size_t, I>, U&& value, Us&&... rest) {
+        auto& c = std::get<I>(columns_);
+        c.emplace_back(std::forward<U>(value));
+        slot_map_detail::append_guard<column_container_type<I>> guard{&c, static_cast<typename column_container_type<I>::size_type>(c.size() - 1)};
+        key_type result = this->append_columns(std::integral_constant<size_t, I + 1>{}, std::forward<Us>(rest)...);
+        guard.ctr = nullptr;
+        return result;
+    }
+    constexpr key_type append_columns(std::integral_constant<size_t, sizeof...(Ts)>) {
+        return this->push_slot(reverse_map_.size());
+    }
+
+    std::tuple<Container<Ts>...> columns_;  // exactly size() entries each
+
+    // Class invariant: as for slot_table, with every column in reverse_map_ order.
+};
+
+template<class Key, template<class...> class Container, class... Ts>
+constexpr void swap(basic_slot_map_soa<Key, Container, Ts...>& lhs, basic_slot_map_soa<Key, Container, Ts...>& rhs) {
+    lhs.swap(rhs);
+}
+
+template<class Key, class... Ts>
+using slot_map_soa = basic_slot_map_soa<Key, std::vector, Ts...>;
+
 } // namespace stdext
@@ -0,0 +1,95 @@
+#if !defined SG14_BENCH_2020_03_14_12_00
+#define SG14_BENCH_2020_03_14_12_00
+
+#include <stddef.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace sg14_bench
+{
+    void algorithm_ext_bench();
+    void eytzinger_set_bench();
+    void flat_map_bench();
+    void flat_set_bench();
+    void inplace_function_bench();
+    void plf_colony_bench();
+    void ring_bench();
+    void slot_map_bench();
+
+    // One row of the JSON report. "suite" names the SG14 component under test,
+    // "name" the operation, and "subject" the concrete type that was timed, so
+    // that an SG14 container and its std counterpart share suite and name.
+    struct result
+    {
+        std::string suite;
+        std::string name;
+        std::string subject;
+        size_t n;
+        size_t repetitions;
+        double ns_per_op;
+    };
+
+    std::vector<result>& results();
+    size_t repetitions();
+
+    // Keeps the optimizer from discarding a computed value.
+    template<class T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = std::addressof(value);
+#endif
+    }
+
+    // Every benchmark draws its input from a freshly seeded engine, so the
+    // data does not depend on which suites ran before it.
+    inline std::mt19937 rng()
+    {
+        return std::mt19937(0x5614);
+    }
+
+    inline std::vector<int> shuffled_ints(size_t n)
+    {
+        std::vector<int> v(n);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        auto engine = rng();
+        std::shuffle(v.begin(), v.end(), engine);
+        return v;
+    }
+
+    // Runs setup() and then body(state) repetitions() times, and records the
+    // fastest run of body divided by n. Only body is timed.
+    template<class Setup, class Body>
+    void measure(const char* suite, const char* name, const char* subject, size_t n, Setup setup, Body body)
+    {
+        using clock = std::chrono::steady_clock;
+        double best = std::numeric_limits<double>::max();
+        for (size_t rep = 0; rep < repetitions(); ++rep) {
+            auto state = setup();
+            auto t0 = clock::now();
+            body(state);
+            auto t1 = clock::now();
+            do_not_optimize(state);
+            best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        results().push_back(result{suite, name, subject, n, repetitions(), best / static_cast<double>(n ? n : 1)});
+    }
+
+    template<class Body>
+    void measure(const char* suite, const char* name, const char* subject, size_t n, Body body)
+    {
+        sg14_bench::measure(suite, name, subject, n, [] { return 0; }, [&](int&) { body(); });
+    }
+}
+
+#endif
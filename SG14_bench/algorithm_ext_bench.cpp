@@ -0,0 +1,71 @@
+#include "SG14_bench.h"
+#include "algorithm_ext.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 100000;
+
+struct payload {
+    std::array<int, 16> info;
+};
+
+std::vector<payload> make_payloads()
+{
+    auto engine = sg14_bench::rng();
+    std::vector<payload> v(N);
+    for (auto& p : v) {
+        p.info.fill(static_cast<int>(engine()));
+    }
+    return v;
+}
+
+bool is_odd(const payload& p) { return (p.info[0] & 1) != 0; }
+
+} // namespace
+
+void sg14_bench::algorithm_ext_bench()
+{
+    sg14_bench::measure("algorithm_ext", "remove_if", "stdext::unstable_remove_if", N, make_payloads, [](std::vector<payload>& v) {
+        v.erase(stdext::unstable_remove_if(v.begin(), v.end(), is_odd), v.end());
+    });
+    sg14_bench::measure("algorithm_ext", "remove_if", "std::remove_if", N, make_payloads, [](std::vector<payload>& v) {
+        v.erase(std::remove_if(v.begin(), v.end(), is_odd), v.end());
+    });
+    sg14_bench::measure("algorithm_ext", "remove_if", "std::partition", N, make_payloads, [](std::vector<payload>& v) {
+        v.erase(std::partition(v.begin(), v.end(), [](const payload& p) { return !is_odd(p); }), v.end());
+    });
+
+    auto make_strings = [] { return std::vector<std::string>(N, std::string(32, 'x')); };
+    auto raw_buffer = [] { return std::unique_ptr<char[]>(new char[N * sizeof(std::string)]); };
+
+    sg14_bench::measure("algorithm_ext", "uninitialized_move", "stdext::uninitialized_move", N, make_strings, [&](std::vector<std::string>& v) {
+        auto buf = raw_buffer();
+        auto first = reinterpret_cast<std::string*>(buf.get());
+        auto last = stdext::uninitialized_move(v.begin(), v.end(), first);
+        stdext::destruct(first, last);
+    });
+    sg14_bench::measure("algorithm_ext", "uninitialized_move", "std::uninitialized_copy", N, make_strings, [&](std::vector<std::string>& v) {
+        auto buf = raw_buffer();
+        auto first = reinterpret_cast<std::string*>(buf.get());
+        auto last = std::uninitialized_copy(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()), first);
+        stdext::destruct(first, last);
+    });
+
+    sg14_bench::measure("algorithm_ext", "uninitialized_value_construct", "stdext::uninitialized_value_construct", N, [&] {
+        auto buf = raw_buffer();
+        auto first = reinterpret_cast<std::string*>(buf.get());
+        auto last = stdext::uninitialized_value_construct(first, first + N);
+        stdext::destruct(first, last);
+    });
+    sg14_bench::measure("algorithm_ext", "uninitialized_value_construct", "std::uninitialized_fill", N, [&] {
+        auto buf = raw_buffer();
+        auto first = reinterpret_cast<std::string*>(buf.get());
+        std::uninitialized_fill(first, first + N, std::string());
+        stdext::destruct(first, first + N);
+    });
+}
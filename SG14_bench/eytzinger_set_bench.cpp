@@ -0,0 +1,57 @@
+#include "SG14_bench.h"
+#include "eytzinger_set.h"
+#include "flat_set.h"
+#include <set>
+#include <vector>
+
+namespace {
+
+// Large enough that the keys no longer fit in cache, which is the case the
+// Eytzinger layout is for.
+constexpr size_t N = 4000000;
+constexpr size_t Lookups = 1000000;
+
+template<class Set>
+void set_suite(const char* subject)
+{
+    const std::vector<int> keys = sg14_bench::shuffled_ints(N);
+
+    sg14_bench::measure("eytzinger_set", "construct_from_range", subject, N, [&] {
+        Set s(keys.begin(), keys.end());
+        sg14_bench::do_not_optimize(s);
+    });
+
+    const Set s(keys.begin(), keys.end());
+    sg14_bench::measure("eytzinger_set", "find", subject, Lookups, [&] {
+        long sum = 0;
+        for (size_t i = 0; i < Lookups; ++i) {
+            sum += *s.find(keys[i]);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("eytzinger_set", "lower_bound", subject, Lookups, [&] {
+        long sum = 0;
+        for (size_t i = 0; i < Lookups; ++i) {
+            sum += (s.lower_bound(keys[i]) != s.end());
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("eytzinger_set", "iterate", subject, N, [&] {
+        long sum = 0;
+        for (int k : s) {
+            sum += k;
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+void sg14_bench::eytzinger_set_bench()
+{
+    set_suite<stdext::eytzinger_set<int>>("stdext::eytzinger_set");
+    set_suite<stdext::flat_set<int>>("stdext::flat_set");
+    set_suite<std::set<int>>("std::set");
+}
@@ -0,0 +1,63 @@
+#include "SG14_bench.h"
+#include "flat_map.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 100000;
+
+template<class Map>
+void map_suite(const char* subject)
+{
+    const std::vector<int> keys = sg14_bench::shuffled_ints(N);
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(N);
+    for (int k : keys) {
+        pairs.emplace_back(k, k);
+    }
+
+    sg14_bench::measure("flat_map", "construct_from_range", subject, N, [&] {
+        Map m(pairs.begin(), pairs.end());
+        sg14_bench::do_not_optimize(m);
+    });
+
+    sg14_bench::measure("flat_map", "insert_one_by_one", subject, N / 10, [&] {
+        Map m;
+        for (size_t i = 0; i < N / 10; ++i) {
+            m.insert(pairs[i]);
+        }
+        sg14_bench::do_not_optimize(m);
+    });
+
+    sg14_bench::measure("flat_map", "insert_range", subject, N / 2,
+        [&] { return Map(pairs.begin(), pairs.begin() + N / 2); },
+        [&](Map& m) { m.insert(pairs.begin() + N / 2, pairs.end()); }
+    );
+
+    const Map m(pairs.begin(), pairs.end());
+    sg14_bench::measure("flat_map", "find", subject, N, [&] {
+        long sum = 0;
+        for (int k : keys) {
+            sum += m.find(k)->second;
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("flat_map", "iterate", subject, N, [&] {
+        long sum = 0;
+        for (auto&& kv : m) {
+            sum += kv.second;
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+void sg14_bench::flat_map_bench()
+{
+    map_suite<stdext::flat_map<int, int>>("stdext::flat_map");
+    map_suite<std::map<int, int>>("std::map");
+}
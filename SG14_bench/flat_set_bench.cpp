@@ -0,0 +1,76 @@
+#include "SG14_bench.h"
+#include "flat_set.h"
+#include <set>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 100000;
+
+template<class It>
+void insert_sorted(stdext::flat_set<int>& s, It first, It last) { s.insert(stdext::sorted_unique, first, last); }
+
+template<class It>
+void insert_sorted(std::set<int>& s, It first, It last) { s.insert(first, last); }
+
+template<class Set>
+void set_suite(const char* subject)
+{
+    const std::vector<int> keys = sg14_bench::shuffled_ints(N);
+
+    sg14_bench::measure("flat_set", "construct_from_range", subject, N, [&] {
+        Set s(keys.begin(), keys.end());
+        sg14_bench::do_not_optimize(s);
+    });
+
+    sg14_bench::measure("flat_set", "insert_one_by_one", subject, N / 10, [&] {
+        Set s;
+        for (size_t i = 0; i < N / 10; ++i) {
+            s.insert(keys[i]);
+        }
+        sg14_bench::do_not_optimize(s);
+    });
+
+    // Merging a sorted batch of every other key into a set holding the rest.
+    std::vector<int> evens, odds;
+    for (size_t i = 0; i < N; ++i) {
+        (i % 2 ? odds : evens).push_back(static_cast<int>(i));
+    }
+    sg14_bench::measure("flat_set", "insert_sorted_range", subject, N / 2,
+        [&] { return Set(evens.begin(), evens.end()); },
+        [&](Set& s) { insert_sorted(s, odds.begin(), odds.end()); }
+    );
+
+    const Set s(keys.begin(), keys.end());
+    sg14_bench::measure("flat_set", "find", subject, N, [&] {
+        long sum = 0;
+        for (int k : keys) {
+            sum += *s.find(k);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("flat_set", "lower_bound", subject, N, [&] {
+        long sum = 0;
+        for (int k : keys) {
+            sum += (s.lower_bound(k) != s.end());
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("flat_set", "iterate", subject, N, [&] {
+        long sum = 0;
+        for (int k : s) {
+            sum += k;
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+void sg14_bench::flat_set_bench()
+{
+    set_suite<stdext::flat_set<int>>("stdext::flat_set");
+    set_suite<std::set<int>>("std::set");
+}
@@ -0,0 +1,111 @@
+#include "SG14_bench.h"
+#include "inplace_function.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 1000000;
+constexpr size_t Callbacks = 1000;
+
+template<class Function>
+void function_suite(const char* subject)
+{
+    // Three captured words: small enough for inplace_function's default
+    // capacity, large enough to defeat std::function's small-object buffer
+    // on common implementations.
+    sg14_bench::measure("inplace_function", "construct_invoke_destroy", subject, N, [] {
+        long sum = 0;
+        for (size_t i = 0; i < N; ++i) {
+            long a = static_cast<long>(i), b = 1, c = 2;
+            Function f = [a, b, c](int x) { return a + b + c + x; };
+            sg14_bench::do_not_optimize(f);
+            sum += f(1);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    std::vector<Function> fns;
+    for (size_t i = 0; i < Callbacks; ++i) {
+        long a = static_cast<long>(i), b = 1, c = 2;
+        fns.emplace_back([a, b, c](int x) { return a + b + c + x; });
+    }
+
+    sg14_bench::measure("inplace_function", "invoke", subject, Callbacks * 1000, [&] {
+        long sum = 0;
+        for (int rep = 0; rep < 1000; ++rep) {
+            for (const auto& f : fns) {
+                sum += f(rep);
+            }
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("inplace_function", "move", subject, Callbacks * 100,
+        [&] { return fns; },
+        [&](std::vector<Function>& v) {
+            for (int rep = 0; rep < 100; ++rep) {
+                for (auto& f : v) {
+                    Function tmp = std::move(f);
+                    f = std::move(tmp);
+                }
+            }
+        }
+    );
+
+    sg14_bench::measure("inplace_function", "copy", subject, Callbacks * 100, [&] {
+        long sum = 0;
+        for (int rep = 0; rep < 100; ++rep) {
+            for (const auto& f : fns) {
+                Function copy = f;
+                sg14_bench::do_not_optimize(copy);
+                sum += copy(rep);
+            }
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+}
+
+// A task owning a move-only resource, moved through a queue a few times
+// before it runs. std::function needs the resource behind a shared_ptr.
+void move_only_task_suite()
+{
+    sg14_bench::measure("inplace_function", "move_only_task", "stdext::inplace_unique_function", N, [] {
+        long sum = 0;
+        for (size_t i = 0; i < N; ++i) {
+            auto p = std::make_unique<long>(static_cast<long>(i));
+            stdext::inplace_unique_function<long(int)> f = [p = std::move(p)](int x) { return *p + x; };
+            auto g = std::move(f);
+            auto h = std::move(g);
+            sum += h(1);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("inplace_function", "move_only_task", "std::function + std::shared_ptr", N, [] {
+        long sum = 0;
+        for (size_t i = 0; i < N; ++i) {
+            auto p = std::make_shared<long>(static_cast<long>(i));
+            std::function<long(int)> f = [p = std::move(p)](int x) { return *p + x; };
+            auto g = std::move(f);
+            auto h = std::move(g);
+            sum += h(1);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+void sg14_bench::inplace_function_bench()
+{
+    function_suite<stdext::inplace_function<long(int)>>("stdext::inplace_function");
+    function_suite<stdext::inplace_function<long(int), 32, alignof(stdext::inplace_function_detail::aligned_storage_t<32>), true>>(
+        "stdext::inplace_function (inline invoker)"
+    );
+    function_suite<stdext::small_function<long(int)>>("stdext::small_function");
+    function_suite<stdext::small_function<long(int), 16>>("stdext::small_function (spilled)");
+    function_suite<std::function<long(int)>>("std::function");
+    move_only_task_suite();
+}
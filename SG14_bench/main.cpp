@@ -0,0 +1,110 @@
+#if defined(_MSC_VER)
+#include <SDKDDKVer.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SG14_bench.h"
+
+namespace {
+
+size_t g_repetitions = 5;
+
+void print_json_string(const std::string& s)
+{
+    putchar('"');
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            putchar('\\');
+        }
+        putchar(c);
+    }
+    putchar('"');
+}
+
+void print_json_report()
+{
+    const auto& rs = sg14_bench::results();
+    printf("{\n");
+    printf("  \"context\": {\n");
+#if defined(__clang__)
+    printf("    \"compiler\": \"clang %d.%d.%d\",\n", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+    printf("    \"compiler\": \"gcc %d.%d.%d\",\n", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    printf("    \"compiler\": \"msvc %d\",\n", _MSC_VER);
+#else
+    printf("    \"compiler\": \"unknown\",\n");
+#endif
+    printf("    \"cplusplus\": %ld,\n", static_cast<long>(__cplusplus));
+#if defined(NDEBUG)
+    printf("    \"assertions\": false,\n");
+#else
+    printf("    \"assertions\": true,\n");
+#endif
+    printf("    \"repetitions\": %zu\n", g_repetitions);
+    printf("  },\n");
+    printf("  \"benchmarks\": [");
+    for (size_t i = 0; i < rs.size(); ++i) {
+        printf(i == 0 ? "\n    {" : ",\n    {");
+        printf("\"suite\": ");
+        print_json_string(rs[i].suite);
+        printf(", \"name\": ");
+        print_json_string(rs[i].name);
+        printf(", \"subject\": ");
+        print_json_string(rs[i].subject);
+        printf(", \"n\": %zu, \"repetitions\": %zu, \"ns_per_op\": %.3f}", rs[i].n, rs[i].repetitions, rs[i].ns_per_op);
+    }
+    printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+std::vector<sg14_bench::result>& sg14_bench::results()
+{
+    static std::vector<result> r;
+    return r;
+}
+
+size_t sg14_bench::repetitions()
+{
+    return g_repetitions;
+}
+
+// Usage: sg14_bench [--repetitions=N] [suite...]
+// With no suite arguments every suite is run. The report goes to stdout as JSON.
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--repetitions=", 14) == 0) {
+            g_repetitions = static_cast<size_t>(strtoul(argv[i] + 14, nullptr, 10));
+            if (g_repetitions == 0) {
+                g_repetitions = 1;
+            }
+        } else {
+            selected.push_back(argv[i]);
+        }
+    }
+
+    auto run = [&](const char* suite, void (*fn)()) {
+        if (selected.empty() || std::find(selected.begin(), selected.end(), suite) != selected.end()) {
+            fn();
+        }
+    };
+
+    run("algorithm_ext", sg14_bench::algorithm_ext_bench);
+    run("eytzinger_set", sg14_bench::eytzinger_set_bench);
+    run("flat_map", sg14_bench::flat_map_bench);
+    run("flat_set", sg14_bench::flat_set_bench);
+    run("inplace_function", sg14_bench::inplace_function_bench);
+    run("plf_colony", sg14_bench::plf_colony_bench);
+    run("ring", sg14_bench::ring_bench);
+    run("slot_map", sg14_bench::slot_map_bench);
+
+    print_json_report();
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "SG14_bench.h"
+#include "plf_colony.h"
+#include <algorithm>
+#include <list>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 200000;
+
+struct entity {
+    int id;
+    float x, y, z;
+    float vx, vy, vz;
+};
+
+entity make_entity(size_t i)
+{
+    float f = static_cast<float>(i);
+    return entity{static_cast<int>(i), f, f, f, 1.0f, 2.0f, 3.0f};
+}
+
+template<class Container>
+Container filled()
+{
+    Container c;
+    for (size_t i = 0; i < N; ++i) {
+        c.insert(c.end(), make_entity(i));
+    }
+    return c;
+}
+
+plf::colony<entity> filled_colony()
+{
+    plf::colony<entity> c;
+    for (size_t i = 0; i < N; ++i) {
+        c.insert(make_entity(i));
+    }
+    return c;
+}
+
+// Erases every element whose id has the low bit set, the way a despawn pass
+// walking a container would.
+template<class Container>
+void erase_odd(Container& c)
+{
+    for (auto it = c.begin(); it != c.end(); ) {
+        if (it->id & 1) {
+            it = c.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template<class Container>
+void update(Container& c)
+{
+    for (auto& e : c) {
+        e.x += e.vx;
+        e.y += e.vy;
+        e.z += e.vz;
+    }
+}
+
+void visit_update(plf::colony<entity>& c)
+{
+    c.visit([](entity& e) {
+        e.x += e.vx;
+        e.y += e.vy;
+        e.z += e.vz;
+    });
+}
+
+} // namespace
+
+void sg14_bench::plf_colony_bench()
+{
+    sg14_bench::measure("plf_colony", "insert", "plf::colony", N, [] {
+        sg14_bench::do_not_optimize(filled_colony());
+    });
+    sg14_bench::measure("plf_colony", "insert", "std::list", N, [] {
+        sg14_bench::do_not_optimize(filled<std::list<entity>>());
+    });
+    sg14_bench::measure("plf_colony", "insert", "std::vector", N, [] {
+        sg14_bench::do_not_optimize(filled<std::vector<entity>>());
+    });
+
+    sg14_bench::measure("plf_colony", "erase_half", "plf::colony", N / 2, filled_colony, erase_odd<plf::colony<entity>>);
+    sg14_bench::measure("plf_colony", "erase_half", "plf::colony (erase_if)", N / 2, filled_colony,
+        [](plf::colony<entity>& c) { c.erase_if([](const entity& e) { return (e.id & 1) != 0; }); }
+    );
+    sg14_bench::measure("plf_colony", "erase_half", "std::list", N / 2, filled<std::list<entity>>, erase_odd<std::list<entity>>);
+    sg14_bench::measure("plf_colony", "erase_half", "std::vector", N / 2, filled<std::vector<entity>>,
+        [](std::vector<entity>& v) {
+            v.erase(std::remove_if(v.begin(), v.end(), [](const entity& e) { return (e.id & 1) != 0; }), v.end());
+        }
+    );
+
+    sg14_bench::measure("plf_colony", "update", "plf::colony", N, filled_colony, update<plf::colony<entity>>);
+    sg14_bench::measure("plf_colony", "update", "plf::colony (visit)", N, filled_colony, visit_update);
+    sg14_bench::measure("plf_colony", "update", "std::vector", N, filled<std::vector<entity>>, update<std::vector<entity>>);
+
+    // Iteration is timed after erasing half the elements, so the colony has
+    // to skip over erased slots.
+    auto sparse_colony = [] { auto c = filled_colony(); erase_odd(c); return c; };
+    auto sparse_list = [] { auto c = filled<std::list<entity>>(); erase_odd(c); return c; };
+    auto sparse_vector = [] { auto c = filled<std::vector<entity>>(); erase_odd(c); return c; };
+
+    sg14_bench::measure("plf_colony", "update_after_erase", "plf::colony", N / 2, sparse_colony, update<plf::colony<entity>>);
+    sg14_bench::measure("plf_colony", "update_after_erase", "plf::colony (visit)", N / 2, sparse_colony, visit_update);
+#if defined(PLF_COLONY_PARALLEL_SORT) && __cplusplus >= 201703L
+    sg14_bench::measure("plf_colony", "update_after_erase", "plf::colony (for_each par)", N / 2, sparse_colony,
+        [](plf::colony<entity>& c) {
+            c.for_each(std::execution::par, [](entity& e) {
+                e.x += e.vx;
+                e.y += e.vy;
+                e.z += e.vz;
+            });
+        }
+    );
+#endif
+    sg14_bench::measure("plf_colony", "update_after_erase", "std::list", N / 2, sparse_list, update<std::list<entity>>);
+    sg14_bench::measure("plf_colony", "update_after_erase", "std::vector", N / 2, sparse_vector, update<std::vector<entity>>);
+
+    auto by_x_descending = [](const entity& a, const entity& b) { return a.x > b.x; };
+    sg14_bench::measure("plf_colony", "sort", "plf::colony", N, filled_colony,
+        [&](plf::colony<entity>& c) { c.sort(by_x_descending); }
+    );
+    sg14_bench::measure("plf_colony", "sort", "plf::colony (sort_by_key)", N, filled_colony,
+        [](plf::colony<entity>& c) { c.sort_by_key([](const entity& e) { return -e.x; }); }
+    );
+#if defined(PLF_COLONY_PARALLEL_SORT) && __cplusplus >= 201703L
+    sg14_bench::measure("plf_colony", "sort", "plf::colony (par_unseq)", N, filled_colony,
+        [&](plf::colony<entity>& c) { c.sort(std::execution::par_unseq, by_x_descending); }
+    );
+#endif
+    sg14_bench::measure("plf_colony", "sort", "std::list", N, filled<std::list<entity>>,
+        [&](std::list<entity>& c) { c.sort(by_x_descending); }
+    );
+    sg14_bench::measure("plf_colony", "sort", "std::vector", N, filled<std::vector<entity>>,
+        [&](std::vector<entity>& c) { std::sort(c.begin(), c.end(), by_x_descending); }
+    );
+
+    // Integral keys let sort_by_key use a radix sort. The key scrambles the
+    // insertion order, so that neither sort sees presorted input.
+    auto scrambled_id = [](const entity& e) { return static_cast<unsigned>(e.id) * 2654435761u; };
+    auto by_scrambled_id = [&](const entity& a, const entity& b) { return scrambled_id(a) < scrambled_id(b); };
+    sg14_bench::measure("plf_colony", "sort_int_key", "plf::colony", N, filled_colony,
+        [&](plf::colony<entity>& c) { c.sort(by_scrambled_id); }
+    );
+    sg14_bench::measure("plf_colony", "sort_int_key", "plf::colony (sort_by_key)", N, filled_colony,
+        [&](plf::colony<entity>& c) { c.sort_by_key(scrambled_id); }
+    );
+    sg14_bench::measure("plf_colony", "sort_int_key", "std::vector", N, filled<std::vector<entity>>,
+        [&](std::vector<entity>& c) { std::sort(c.begin(), c.end(), by_scrambled_id); }
+    );
+}
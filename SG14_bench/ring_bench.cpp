@@ -0,0 +1,424 @@
+#include "SG14_bench.h"
+#include "ring.h"
+#include "mirrored_buffer.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 1000000;
+constexpr size_t Capacity = 1024;
+
+// Capacity, hidden from the optimizer the way a runtime-sized buffer is, so
+// that ring_span's modulo is not folded into a mask.
+size_t runtime_capacity()
+{
+    static volatile size_t capacity = Capacity;
+    return capacity;
+}
+
+// Hands N ints from a producer thread to the calling thread. try_push and
+// try_pop spin (yielding) until they succeed.
+template<class TryPush, class TryPop>
+long transfer(TryPush try_push, TryPop try_pop)
+{
+    std::thread producer([&] {
+        for (size_t i = 0; i < N; ) {
+            if (try_push(static_cast<int>(i))) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    long sum = 0;
+    for (size_t i = 0; i < N; ) {
+        int x;
+        if (try_pop(x)) {
+            sum += x;
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return sum;
+}
+
+// Splits threads into producers and consumers (a single thread does both)
+// which together hand over n ints, the way a pool of workers shares a job
+// queue.
+template<class TryPush, class TryPop>
+void contend(int threads, size_t n, TryPush try_push, TryPop try_pop)
+{
+    int producers = (threads + 1) / 2;
+    int consumers = threads - producers;
+    if (consumers == 0) {
+        for (size_t i = 0; i < n; ++i) {
+            int x = 0;
+            try_push(static_cast<int>(i));
+            try_pop(x);
+            sg14_bench::do_not_optimize(x);
+        }
+        return;
+    }
+    std::atomic<size_t> popped(0);
+    std::vector<std::thread> pool;
+    for (int p = 0; p < producers; ++p) {
+        pool.emplace_back([&, p] {
+            size_t count = n / producers + (static_cast<size_t>(p) < n % producers);
+            for (size_t i = 0; i < count; ) {
+                if (try_push(static_cast<int>(i))) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        pool.emplace_back([&] {
+            long sum = 0;
+            while (popped.load(std::memory_order_relaxed) < n) {
+                int x;
+                if (try_pop(x)) {
+                    sum += x;
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+} // namespace
+
+void sg14_bench::ring_bench()
+{
+    // A producer that stays half a buffer ahead of its consumer.
+    sg14_bench::measure("ring", "push_pop_steady_state", "sg14::ring_span", N, [] {
+        std::vector<int> storage(runtime_capacity());
+        sg14::ring_span<int> r(storage.begin(), storage.end());
+        long sum = 0;
+        for (size_t i = 0; i < Capacity / 2; ++i) {
+            r.push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < N; ++i) {
+            r.push_back(static_cast<int>(i));
+            sum += r.pop_front();
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "push_pop_steady_state", "sg14::pow2_ring_span", N, [] {
+        std::vector<int> storage(runtime_capacity());
+        sg14::pow2_ring_span<int> r(storage.begin(), storage.end());
+        long sum = 0;
+        for (size_t i = 0; i < Capacity / 2; ++i) {
+            r.push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < N; ++i) {
+            r.push_back(static_cast<int>(i));
+            sum += r.pop_front();
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "push_pop_steady_state", "sg14::static_ring", N, [] {
+        auto r = std::make_unique<sg14::static_ring<int, Capacity>>();
+        long sum = 0;
+        for (size_t i = 0; i < Capacity / 2; ++i) {
+            r->push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < N; ++i) {
+            r->push_back(static_cast<int>(i));
+            sum += r->pop_front();
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "push_pop_steady_state", "std::deque", N, [] {
+        std::deque<int> r;
+        long sum = 0;
+        for (size_t i = 0; i < Capacity / 2; ++i) {
+            r.push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < N; ++i) {
+            r.push_back(static_cast<int>(i));
+            sum += r.front();
+            r.pop_front();
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    // Overwriting the oldest element once the buffer is full; std::deque has
+    // to pop explicitly to get the same bounded behaviour.
+    sg14_bench::measure("ring", "push_back_overwrite", "sg14::ring_span", N, [] {
+        std::vector<int> storage(runtime_capacity());
+        sg14::ring_span<int> r(storage.begin(), storage.end());
+        for (size_t i = 0; i < N; ++i) {
+            r.push_back(static_cast<int>(i));
+        }
+        sg14_bench::do_not_optimize(r.front());
+    });
+
+    sg14_bench::measure("ring", "push_back_overwrite", "sg14::pow2_ring_span", N, [] {
+        std::vector<int> storage(runtime_capacity());
+        sg14::pow2_ring_span<int> r(storage.begin(), storage.end());
+        for (size_t i = 0; i < N; ++i) {
+            r.push_back(static_cast<int>(i));
+        }
+        sg14_bench::do_not_optimize(r.front());
+    });
+
+    sg14_bench::measure("ring", "push_back_overwrite", "std::deque", N, [] {
+        std::deque<int> r;
+        for (size_t i = 0; i < N; ++i) {
+            if (r.size() == Capacity) {
+                r.pop_front();
+            }
+            r.push_back(static_cast<int>(i));
+        }
+        sg14_bench::do_not_optimize(r.front());
+    });
+
+    std::vector<int> storage(runtime_capacity());
+    sg14::ring_span<int> full_ring(storage.begin(), storage.end());
+    std::vector<int> pow2_storage(runtime_capacity());
+    sg14::pow2_ring_span<int> full_pow2_ring(pow2_storage.begin(), pow2_storage.end());
+    std::deque<int> full_deque;
+    for (size_t i = 0; i < Capacity + Capacity / 2; ++i) {
+        full_ring.push_back(static_cast<int>(i));
+        full_pow2_ring.push_back(static_cast<int>(i));
+        if (full_deque.size() == Capacity) {
+            full_deque.pop_front();
+        }
+        full_deque.push_back(static_cast<int>(i));
+    }
+
+    sg14_bench::measure("ring", "iterate", "sg14::ring_span", Capacity * 100, [&] {
+        long sum = 0;
+        for (int rep = 0; rep < 100; ++rep) {
+            for (int x : full_ring) {
+                sum += x;
+            }
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "iterate", "sg14::pow2_ring_span", Capacity * 100, [&] {
+        long sum = 0;
+        for (int rep = 0; rep < 100; ++rep) {
+            for (int x : full_pow2_ring) {
+                sum += x;
+            }
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "iterate", "std::deque", Capacity * 100, [&] {
+        long sum = 0;
+        for (int rep = 0; rep < 100; ++rep) {
+            for (int x : full_deque) {
+                sum += x;
+            }
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    // Moving 256-byte packets through a byte ring, one byte at a time or a
+    // segment at a time.
+    constexpr size_t Packet = 256;
+    constexpr size_t Bytes = 16 * 1024 * 1024;
+    sg14_bench::measure("ring", "packet_copy", "sg14::ring_span (per byte)", Bytes, [] {
+        std::vector<unsigned char> storage(4 * 1024), in(Packet, 1), out(Packet);
+        sg14::ring_span<unsigned char> r(storage.begin(), storage.end());
+        for (size_t i = 0; i < Bytes / Packet; ++i) {
+            for (unsigned char c : in) {
+                r.push_back(c);
+            }
+            for (unsigned char& c : out) {
+                c = r.pop_front();
+            }
+        }
+        sg14_bench::do_not_optimize(out);
+    });
+
+    sg14_bench::measure("ring", "packet_copy", "sg14::ring_span (segments)", Bytes, [] {
+        std::vector<unsigned char> storage(4 * 1024), in(Packet, 1), out(Packet);
+        sg14::ring_span<unsigned char> r(storage.begin(), storage.end());
+        // Offset by a fraction of a packet, so that some packets wrap.
+        r.commit(100);
+        r.consume(100);
+        for (size_t i = 0; i < Bytes / Packet; ++i) {
+            auto w = r.write_segments(Packet);
+            std::memcpy(w.first.data, in.data(), w.first.size);
+            std::memcpy(w.second.data, in.data() + w.first.size, w.second.size);
+            r.commit(Packet);
+            auto rd = r.read_segments(Packet);
+            std::memcpy(out.data(), rd.first.data, rd.first.size);
+            std::memcpy(out.data() + rd.first.size, rd.second.data, rd.second.size);
+            r.consume(Packet);
+        }
+        sg14_bench::do_not_optimize(out);
+    });
+
+    // A short-lived queue of strings, where ring_span pays for default
+    // constructing every slot of its buffer up front.
+    constexpr size_t Queues = 10000;
+    constexpr size_t Small = 64;
+    sg14_bench::measure("ring", "construct_and_fill", "sg14::ring_span", Queues * 8, [] {
+        for (size_t q = 0; q < Queues; ++q) {
+            std::array<std::string, Small> storage;
+            sg14::ring_span<std::string> r(storage.begin(), storage.end());
+            for (int i = 0; i < 8; ++i) {
+                r.emplace_back(static_cast<size_t>(i), 'x');
+            }
+            sg14_bench::do_not_optimize(r.back());
+        }
+    });
+
+    sg14_bench::measure("ring", "construct_and_fill", "sg14::static_ring", Queues * 8, [] {
+        for (size_t q = 0; q < Queues; ++q) {
+            sg14::static_ring<std::string, Small> r;
+            for (int i = 0; i < 8; ++i) {
+                r.emplace_back(static_cast<size_t>(i), 'x');
+            }
+            sg14_bench::do_not_optimize(r.back());
+        }
+    });
+
+#if defined(__linux__)
+    // Checksumming 100-byte records as they stream through a 4 KiB ring.
+    // Some records straddle the wrap point; with plain storage they are
+    // copied out first, with mirrored storage they are read in place.
+    constexpr size_t Record = 100;
+    constexpr size_t Records = 200000;
+    auto checksum = [](const unsigned char* p) {
+        unsigned sum = 0;
+        for (size_t i = 0; i < Record; ++i) {
+            sum = sum * 31 + p[i];
+        }
+        return sum;
+    };
+    sg14_bench::measure("ring", "parse_records", "sg14::ring_span (std::vector storage)", Records, [&] {
+        std::vector<unsigned char> storage(4096), in(Record, 7);
+        sg14::ring_span<unsigned char> r(storage.begin(), storage.end());
+        unsigned char scratch[Record];
+        unsigned sum = 0;
+        for (size_t i = 0; i < Records; ++i) {
+            auto w = r.write_segments(Record);
+            std::memcpy(w.first.data, in.data(), w.first.size);
+            std::memcpy(w.second.data, in.data() + w.first.size, w.second.size);
+            r.commit(Record);
+            auto rd = r.read_segments(Record);
+            const unsigned char* p = rd.first.data;
+            if (rd.second.size != 0) {
+                std::memcpy(scratch, rd.first.data, rd.first.size);
+                std::memcpy(scratch + rd.first.size, rd.second.data, rd.second.size);
+                p = scratch;
+            }
+            sum += checksum(p);
+            r.consume(Record);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+
+    sg14_bench::measure("ring", "parse_records", "sg14::ring_span (sg14::mirrored_buffer)", Records, [&] {
+        sg14::mirrored_buffer<unsigned char> storage(4096);
+        std::vector<unsigned char> in(Record, 7);
+        sg14::ring_span<unsigned char> r(storage.begin(), storage.end());
+        unsigned sum = 0;
+        for (size_t i = 0; i < Records; ++i) {
+            std::memcpy(r.write_segments(Record).first.data, in.data(), Record);
+            r.commit(Record);
+            sum += checksum(&r.front());
+            r.consume(Record);
+        }
+        sg14_bench::do_not_optimize(sum);
+    });
+#endif
+
+    // One producer and one consumer thread.
+    sg14_bench::measure("ring", "spsc_transfer", "sg14::spsc_ring_span", N, [] {
+        std::vector<int> storage(Capacity);
+        sg14::spsc_ring_span<int> r(storage.begin(), storage.end());
+        sg14_bench::do_not_optimize(transfer(
+            [&](int x) { return r.try_push(x); },
+            [&](int& x) { return r.try_pop(x); }
+        ));
+    });
+
+    sg14_bench::measure("ring", "spsc_transfer", "sg14::ring_span + std::mutex", N, [] {
+        std::vector<int> storage(Capacity);
+        sg14::ring_span<int> r(storage.begin(), storage.end());
+        std::mutex m;
+        sg14_bench::do_not_optimize(transfer(
+            [&](int x) {
+                std::lock_guard<std::mutex> lock(m);
+                if (r.full()) {
+                    return false;
+                }
+                r.push_back(x);
+                return true;
+            },
+            [&](int& x) {
+                std::lock_guard<std::mutex> lock(m);
+                if (r.empty()) {
+                    return false;
+                }
+                x = r.pop_front();
+                return true;
+            }
+        ));
+    });
+
+    constexpr size_t Jobs = 200000;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        std::string suffix = " (" + std::to_string(threads) + " threads)";
+        sg14_bench::measure("ring", "mpmc_contention", ("sg14::mpmc_ring_span" + suffix).c_str(), Jobs, [threads] {
+            std::vector<sg14::mpmc_ring_cell<int>> cells(Capacity);
+            sg14::mpmc_ring_span<int> q(cells.begin(), cells.end());
+            contend(threads, Jobs,
+                [&](int x) { return q.try_push(x); },
+                [&](int& x) { return q.try_pop(x); }
+            );
+        });
+
+        sg14_bench::measure("ring", "mpmc_contention", ("std::deque + std::mutex" + suffix).c_str(), Jobs, [threads] {
+            std::deque<int> q;
+            std::mutex m;
+            contend(threads, Jobs,
+                [&](int x) {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (q.size() == Capacity) {
+                        return false;
+                    }
+                    q.push_back(x);
+                    return true;
+                },
+                [&](int& x) {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (q.empty()) {
+                        return false;
+                    }
+                    x = q.front();
+                    q.pop_front();
+                    return true;
+                }
+            );
+        });
+    }
+}
@@ -0,0 +1,270 @@
+#include "SG14_bench.h"
+#include "paged_vector.h"
+#include "slot_map.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t N = 200000;
+
+struct component {
+    float x, y, z, w;
+};
+
+using slot_map_t = stdext::slot_map<component>;
+using key_t = slot_map_t::key_type;
+
+struct filled_slot_map {
+    slot_map_t sm;
+    std::vector<key_t> keys;
+};
+
+filled_slot_map make_slot_map()
+{
+    filled_slot_map result;
+    result.keys.reserve(N);
+    for (size_t i = 0; i < N; ++i) {
+        float f = static_cast<float>(i);
+        result.keys.push_back(result.sm.insert(component{f, f, f, f}));
+    }
+    return result;
+}
+
+using paged_slot_map_t = stdext::slot_map<component, key_t, stdext::paged_vector>;
+
+struct filled_paged_slot_map {
+    paged_slot_map_t sm;
+    std::vector<key_t> keys;
+};
+
+filled_paged_slot_map make_paged_slot_map()
+{
+    filled_paged_slot_map result;
+    result.keys.reserve(N);
+    for (size_t i = 0; i < N; ++i) {
+        float f = static_cast<float>(i);
+        result.keys.push_back(result.sm.insert(component{f, f, f, f}));
+    }
+    return result;
+}
+
+// The same four fields as component, one column each.
+using slot_map_soa_t = stdext::slot_map_soa<key_t, float, float, float, float>;
+
+slot_map_soa_t make_slot_map_soa()
+{
+    slot_map_soa_t sm;
+    for (size_t i = 0; i < N; ++i) {
+        float f = static_cast<float>(i);
+        sm.insert(f, f, f, f);
+    }
+    return sm;
+}
+
+std::unordered_map<unsigned, component> make_unordered_map()
+{
+    std::unordered_map<unsigned, component> m;
+    for (size_t i = 0; i < N; ++i) {
+        float f = static_cast<float>(i);
+        m.emplace(static_cast<unsigned>(i), component{f, f, f, f});
+    }
+    return m;
+}
+
+} // namespace
+
+void sg14_bench::slot_map_bench()
+{
+    sg14_bench::measure("slot_map", "insert", "stdext::slot_map", N, [] {
+        sg14_bench::do_not_optimize(make_slot_map());
+    });
+    const std::vector<component> batch = [] {
+        std::vector<component> v;
+        for (size_t i = 0; i < N; ++i) {
+            float f = static_cast<float>(i);
+            v.push_back(component{f, f, f, f});
+        }
+        return v;
+    }();
+    sg14_bench::measure("slot_map", "insert", "stdext::slot_map (bulk)", N, [&] {
+        filled_slot_map result;
+        result.keys.resize(N);
+        result.sm.insert(batch.begin(), batch.end(), result.keys.begin());
+        sg14_bench::do_not_optimize(result);
+    });
+    sg14_bench::measure("slot_map", "insert", "stdext::slot_map (paged_vector)", N, [] {
+        sg14_bench::do_not_optimize(make_paged_slot_map());
+    });
+    sg14_bench::measure("slot_map", "insert", "std::unordered_map", N, [] {
+        sg14_bench::do_not_optimize(make_unordered_map());
+    });
+    sg14_bench::measure("slot_map", "insert", "std::vector", N, [] {
+        std::vector<component> v;
+        for (size_t i = 0; i < N; ++i) {
+            float f = static_cast<float>(i);
+            v.push_back(component{f, f, f, f});
+        }
+        sg14_bench::do_not_optimize(v);
+    });
+
+    // Lookups happen in shuffled key order, the way a system resolving
+    // handles held by other objects would see them.
+    const std::vector<int> order = sg14_bench::shuffled_ints(N);
+    {
+        const filled_slot_map f = make_slot_map();
+        sg14_bench::measure("slot_map", "find", "stdext::slot_map", N, [&] {
+            float sum = 0;
+            for (int i : order) {
+                sum += f.sm.find(f.keys[static_cast<size_t>(i)])->x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+        std::vector<slot_map_t::key_type> shuffled_keys;
+        for (int i : order) {
+            shuffled_keys.push_back(f.keys[static_cast<size_t>(i)]);
+        }
+        sg14_bench::measure("slot_map", "find", "stdext::slot_map (find loop)", N, [&] {
+            float sum = 0;
+            for (const auto& key : shuffled_keys) {
+                sum += f.sm.find(key)->x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+        std::vector<const component*> ptrs(N);
+        sg14_bench::measure("slot_map", "find", "stdext::slot_map (find_many)", N, [&] {
+            f.sm.find_many(shuffled_keys.begin(), shuffled_keys.end(), ptrs.begin());
+            float sum = 0;
+            for (const component *p : ptrs) {
+                sum += p->x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+        sg14_bench::measure("slot_map", "find", "stdext::slot_map (for_each_key)", N, [&] {
+            float sum = 0;
+            f.sm.for_each_key(shuffled_keys.begin(), shuffled_keys.end(), [&](const component& c) { sum += c.x; });
+            sg14_bench::do_not_optimize(sum);
+        });
+        sg14_bench::measure("slot_map", "iterate", "stdext::slot_map", N, [&] {
+            float sum = 0;
+            for (const auto& c : f.sm) {
+                sum += c.x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+    }
+    {
+        const filled_paged_slot_map f = make_paged_slot_map();
+        sg14_bench::measure("slot_map", "find", "stdext::slot_map (paged_vector)", N, [&] {
+            float sum = 0;
+            for (int i : order) {
+                sum += f.sm.find(f.keys[static_cast<size_t>(i)])->x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+        sg14_bench::measure("slot_map", "iterate", "stdext::slot_map (paged_vector)", N, [&] {
+            float sum = 0;
+            for (const auto& c : f.sm) {
+                sum += c.x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+    }
+    {
+        const auto m = make_unordered_map();
+        sg14_bench::measure("slot_map", "find", "std::unordered_map", N, [&] {
+            float sum = 0;
+            for (int i : order) {
+                sum += m.find(static_cast<unsigned>(i))->second.x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+        sg14_bench::measure("slot_map", "iterate", "std::unordered_map", N, [&] {
+            float sum = 0;
+            for (const auto& kv : m) {
+                sum += kv.second.x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        });
+    }
+
+    // A system pass that reads and writes only one field of each value.
+    sg14_bench::measure("slot_map", "update_one_field", "stdext::slot_map", N, make_slot_map, [](filled_slot_map& f) {
+        for (auto& c : f.sm) {
+            c.x += 1.0f;
+        }
+    });
+    sg14_bench::measure("slot_map", "update_one_field", "stdext::slot_map_soa", N, make_slot_map_soa, [](slot_map_soa_t& sm) {
+        for (float& x : sm.column<0>()) {
+            x += 1.0f;
+        }
+    });
+
+    sg14_bench::measure("slot_map", "erase_by_key", "stdext::slot_map", N / 2, make_slot_map, [&](filled_slot_map& f) {
+        for (size_t i = 0; i < N / 2; ++i) {
+            f.sm.erase(f.keys[static_cast<size_t>(order[i])]);
+        }
+    });
+    sg14_bench::measure("slot_map", "erase_by_key", "std::unordered_map", N / 2, make_unordered_map, [&](std::unordered_map<unsigned, component>& m) {
+        for (size_t i = 0; i < N / 2; ++i) {
+            m.erase(static_cast<unsigned>(order[i]));
+        }
+    });
+
+    // Despawning a contiguous cohort from the middle of the values.
+    sg14_bench::measure("slot_map", "erase_range", "stdext::slot_map", N / 2, make_slot_map, [](filled_slot_map& f) {
+        f.sm.erase(f.sm.begin() + N / 4, f.sm.begin() + 3 * N / 4);
+    });
+    sg14_bench::measure("slot_map", "erase_range", "stdext::slot_map (erase loop)", N / 2, make_slot_map, [](filled_slot_map& f) {
+        for (size_t i = 3 * N / 4; i != N / 4; --i) {
+            f.sm.erase(f.sm.begin() + static_cast<std::ptrdiff_t>(i - 1));
+        }
+    });
+
+    // Refilling after despawning half, so that the free list is consumed.
+    auto half_erased = [&] {
+        filled_slot_map f = make_slot_map();
+        for (size_t i = 0; i < N / 2; ++i) {
+            f.sm.erase(f.keys[static_cast<size_t>(order[i])]);
+        }
+        return f;
+    };
+    sg14_bench::measure("slot_map", "refill_half", "stdext::slot_map", N / 2, half_erased, [&](filled_slot_map& f) {
+        for (size_t i = 0; i < N / 2; ++i) {
+            f.keys[i] = f.sm.insert(batch[i]);
+        }
+    });
+    sg14_bench::measure("slot_map", "refill_half", "stdext::slot_map (bulk)", N / 2, half_erased, [&](filled_slot_map& f) {
+        f.sm.insert(batch.begin(), batch.begin() + N / 2, f.keys.begin());
+    });
+
+    // After churn, values_ no longer follows the order in which a system
+    // walks its keys (here, by x); sorting by that order makes the walk
+    // sequential again.
+    const filled_slot_map churned = [&] {
+        filled_slot_map f = half_erased();
+        for (size_t i = 0; i < N / 2; ++i) {
+            size_t j = static_cast<size_t>(order[i]);
+            f.keys[j] = f.sm.insert(batch[j]);
+        }
+        return f;
+    }();
+    auto by_x = [](const component& a, const component& b) { return a.x < b.x; };
+    sg14_bench::measure("slot_map", "sort", "stdext::slot_map", N, [&] { return churned; }, [&](filled_slot_map& f) {
+        f.sm.sort(by_x);
+    });
+    filled_slot_map sorted = churned;
+    sorted.sm.sort(by_x);
+    auto walk_keys = [](const filled_slot_map& f) {
+        return [&f] {
+            float sum = 0;
+            for (const auto& key : f.keys) {
+                sum += f.sm.find(key)->x;
+            }
+            sg14_bench::do_not_optimize(sum);
+        };
+    };
+    sg14_bench::measure("slot_map", "walk_keys", "stdext::slot_map (churned)", N, walk_keys(churned));
+    sg14_bench::measure("slot_map", "walk_keys", "stdext::slot_map (sorted)", N, walk_keys(sorted));
+}
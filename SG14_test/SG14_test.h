@@ -5,9 +5,11 @@
 
 namespace sg14_test
 {
+    void eytzinger_set_test();
     void flat_map_test();
     void flat_set_test();
     void inplace_function_test();
+    void paged_vector_test();
     void plf_colony_test();
     void ring_test();
     void slot_map_test();
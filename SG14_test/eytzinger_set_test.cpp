@@ -0,0 +1,263 @@
+#include "SG14_test.h"
+#include "eytzinger_set.h"
+#include <algorithm>
+#include <assert.h>
+#include <deque>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+static void BasicTest()
+{
+    using ES = stdext::eytzinger_set<int>;
+    ES es{5, 3, 9, 1, 3, 7};
+    assert(es.size() == 5);
+    assert((std::vector<int>(es.begin(), es.end()) == std::vector<int>{1, 3, 5, 7, 9}));
+    assert((std::vector<int>(es.rbegin(), es.rend()) == std::vector<int>{9, 7, 5, 3, 1}));
+
+    assert(es.contains(7) && !es.contains(4));
+    assert(es.count(9) == 1 && es.count(10) == 0);
+    assert(*es.find(3) == 3);
+    assert(es.find(4) == es.end());
+    assert(*es.lower_bound(4) == 5);
+    assert(*es.lower_bound(5) == 5);
+    assert(*es.upper_bound(5) == 7);
+    assert(es.lower_bound(10) == es.end());
+    assert(es.upper_bound(9) == es.end());
+    assert(es.lower_bound(0) == es.begin());
+
+    auto er = es.equal_range(7);
+    assert(er.first != er.second && *er.first == 7 && *er.second == 9);
+    er = es.equal_range(6);
+    assert(er.first == er.second && *er.first == 7);
+
+    ES empty;
+    assert(empty.begin() == empty.end());
+    assert(empty.find(1) == empty.end());
+    assert(empty.lower_bound(1) == empty.end());
+}
+
+template<class ES, class Set>
+static void RandomizedTest()
+{
+    std::mt19937 g(42);
+    // Every size up to a few full levels, so that each shape of the bottom
+    // level of the tree is visited.
+    for (int n = 0; n < 70; ++n) {
+        Set expected;
+        std::vector<int> input;
+        for (int i = 0; i < n; ++i) {
+            input.push_back(int(g() % 100));
+            expected.insert(input.back());
+        }
+        ES es(input.begin(), input.end());
+        assert(es.size() == expected.size());
+        assert(std::equal(es.begin(), es.end(), expected.begin(), expected.end()));
+        assert(std::equal(es.rbegin(), es.rend(), expected.rbegin(), expected.rend()));
+        for (int k = -1; k <= 100; ++k) {
+            auto it = es.lower_bound(k);
+            auto eit = expected.lower_bound(k);
+            assert(std::distance(es.begin(), it) == std::distance(expected.begin(), eit));
+            it = es.upper_bound(k);
+            eit = expected.upper_bound(k);
+            assert(std::distance(es.begin(), it) == std::distance(expected.begin(), eit));
+            assert(es.contains(k) == (expected.count(k) != 0));
+        }
+    }
+}
+
+static void InsertTest()
+{
+    // Keys compare by .first only, so that we can see which of two
+    // equivalent keys was kept.
+    struct first_less {
+        bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) const { return a.first < b.first; }
+    };
+    using ES = stdext::eytzinger_set<std::pair<int, int>, first_less>;
+    ES es{{4, 0}, {2, 0}, {6, 0}, {2, 1}};
+    assert(es.size() == 3);
+    assert(es.find({2, -1})->second == 0);
+
+    std::vector<std::pair<int, int>> v = {{5, 1}, {1, 1}, {4, 1}, {7, 1}, {5, 2}};
+    es.insert(v.begin(), v.end());
+    assert(es.size() == 6);
+    assert(es.find({4, -1})->second == 0);
+    assert(es.find({5, -1})->second == 1);
+
+    es.insert(stdext::sorted_unique, {{0, 3}, {6, 3}, {8, 3}});
+    assert(es.size() == 8);
+    assert(es.find({6, -1})->second == 0);
+    assert(es.begin()->first == 0);
+    assert(es.rbegin()->first == 8);
+
+    std::vector<std::pair<int, int>> sorted = std::move(es).extract();
+    assert(es.empty());
+    assert(sorted.size() == 8);
+    assert(std::is_sorted(sorted.begin(), sorted.end(), first_less()));
+
+    sorted.erase(sorted.begin() + 2, sorted.end());
+    es.replace(std::move(sorted));
+    assert(es.size() == 2);
+    assert(es.begin()->first == 0 && es.rbegin()->first == 1);
+}
+
+static void TransparentTest()
+{
+    stdext::eytzinger_set<std::string, std::less<>> es{"b", "d", "a", "c"};
+    assert(es.contains("c"));
+    assert(es.count("e") == 0);
+    assert(*es.lower_bound("bb") == "c");
+    assert(*es.upper_bound("b") == "c");
+    auto er = es.equal_range("d");
+    assert(er.first != es.end() && er.second == es.end());
+}
+
+static void ComparisonTest()
+{
+    using ES = stdext::eytzinger_set<int>;
+    ES a{1, 2, 3};
+    ES b(stdext::sorted_unique, {1, 2, 3});
+    ES c{1, 2, 4};
+    assert(a == b);
+    assert(a != c);
+    assert(a < c && c > a && a <= b && a >= b);
+    swap(a, c);
+    assert(*a.rbegin() == 4);
+    a = {9, 8};
+    assert(a.size() == 2 && *a.begin() == 8);
+}
+
+struct CountdownLess {
+    static int compares_until_throw;
+    bool operator()(int a, int b) const {
+        if (compares_until_throw >= 0 && compares_until_throw-- == 0) throw 42;
+        return a < b;
+    }
+};
+int CountdownLess::compares_until_throw = -1;
+
+// Copies throw when the countdown runs out. Moves are noexcept unless
+// NothrowMove is false, in which case the set copies keys to relayout them.
+template<bool NothrowMove>
+struct CountdownKey {
+    static int copies_until_throw;
+    int k_;
+    CountdownKey(int k) : k_(k) {}
+    CountdownKey(const CountdownKey& o) : k_(o.k_) {
+        if (copies_until_throw >= 0 && copies_until_throw-- == 0) throw 42;
+    }
+    CountdownKey(CountdownKey&& o) noexcept(NothrowMove) : k_(o.k_) {}
+    CountdownKey& operator=(const CountdownKey& o) {
+        if (copies_until_throw >= 0 && copies_until_throw-- == 0) throw 42;
+        k_ = o.k_;
+        return *this;
+    }
+    CountdownKey& operator=(CountdownKey&& o) noexcept(NothrowMove) { k_ = o.k_; return *this; }
+
+    friend bool operator<(const CountdownKey& a, const CountdownKey& b) { return a.k_ < b.k_; }
+    friend bool operator==(const CountdownKey& a, const CountdownKey& b) { return a.k_ == b.k_; }
+};
+template<bool NothrowMove> int CountdownKey<NothrowMove>::copies_until_throw = -1;
+
+template<class Key>
+static void ThrowingCopyTest()
+{
+    using ES = stdext::eytzinger_set<Key>;
+    const std::vector<Key> before = {1, 3, 5, 7, 9, 11};
+    const std::vector<Key> batch = {4, 0, 12, 3, 8};
+    bool threw = true;
+    for (int countdown = 0; threw; ++countdown) {
+        ES es(before.begin(), before.end());
+        Key::copies_until_throw = countdown;
+        try {
+            es.insert(batch.begin(), batch.end());
+            threw = false;
+        } catch (int) {
+        }
+        Key::copies_until_throw = -1;
+        if (threw) {
+            assert(std::equal(es.begin(), es.end(), before.begin(), before.end()));
+        } else {
+            assert(es.size() == 10 && es.begin()->k_ == 0 && es.rbegin()->k_ == 12);
+        }
+    }
+}
+
+static void ExceptionTest()
+{
+    // A throw from the comparator at any point leaves the existing keys alone.
+    using ES = stdext::eytzinger_set<int, CountdownLess>;
+    const std::vector<int> before = {1, 3, 5, 7, 9, 11, 13};
+    const std::vector<int> batch = {4, 0, 13, 2, 8, 2};
+    for (bool sorted : {false, true}) {
+        bool threw = true;
+        for (int countdown = 0; threw; ++countdown) {
+            ES es(before.begin(), before.end());
+            std::vector<int> b = batch;
+            if (sorted) {
+                std::sort(b.begin(), b.end());
+                b.erase(std::unique(b.begin(), b.end()), b.end());
+            }
+            CountdownLess::compares_until_throw = countdown;
+            try {
+                if (sorted) {
+                    es.insert(stdext::sorted_unique, b.begin(), b.end());
+                } else {
+                    es.insert(b.begin(), b.end());
+                }
+                threw = false;
+            } catch (int) {
+            }
+            CountdownLess::compares_until_throw = -1;
+            if (threw) {
+                assert(std::equal(es.begin(), es.end(), before.begin(), before.end()));
+            } else {
+                assert((std::vector<int>(es.begin(), es.end()) == std::vector<int>{0, 1, 2, 3, 4, 5, 7, 8, 9, 11, 13}));
+            }
+        }
+    }
+
+    // So does a throw from copying a key in, or from copying keys whose moves may throw.
+    ThrowingCopyTest<CountdownKey<true>>();
+    ThrowingCopyTest<CountdownKey<false>>();
+
+    // extract either succeeds or leaves the set as it was.
+    {
+        using KS = stdext::eytzinger_set<CountdownKey<false>>;
+        KS ks{5, 1, 3, 2, 4};
+        CountdownKey<false>::copies_until_throw = 2;
+        try {
+            auto c = std::move(ks).extract();
+            assert(false);
+        } catch (int) {
+        }
+        CountdownKey<false>::copies_until_throw = -1;
+        assert(ks.size() == 5 && ks.begin()->k_ == 1 && ks.rbegin()->k_ == 5);
+    }
+}
+
+} // anonymous namespace
+
+void sg14_test::eytzinger_set_test()
+{
+    BasicTest();
+    RandomizedTest<stdext::eytzinger_set<int>, std::set<int>>();
+    RandomizedTest<stdext::eytzinger_set<int, std::greater<int>>, std::set<int, std::greater<int>>>();
+    RandomizedTest<stdext::eytzinger_set<int, std::less<int>, std::deque<int>>, std::set<int>>();
+    InsertTest();
+    TransparentTest();
+    ComparisonTest();
+    ExceptionTest();
+}
+
+#ifdef TEST_MAIN
+int main()
+{
+    sg14_test::eytzinger_set_test();
+}
+#endif
@@ -1,12 +1,15 @@
 #include "SG14_test.h"
 #include "flat_map.h"
+#include <algorithm>
 #include <assert.h>
 #include <deque>
 #include <functional>
 #include <list>
+#include <map>
 #if __has_include(<memory_resource>)
 #include <memory_resource>
 #endif
+#include <random>
 #include <string>
 #include <vector>
 
@@ -127,6 +130,151 @@ static void MoveOperationsPilferOwnership()
     assert(InstrumentedWidget::copy_ctors == 0);
 }
 
+static void RangeInsertTest()
+{
+    using FM = stdext::flat_map<int, std::string>;
+    FM fm{{2, "two"}, {4, "four"}, {6, "six"}};
+    std::vector<std::pair<int, std::string>> v = {
+        {5, "five"}, {4, "FOUR"}, {1, "one"}, {5, "FIVE"}, {7, "seven"}, {3, "three"}, {1, "ONE"},
+    };
+    fm.insert(v.begin(), v.end());
+    // Existing keys are not overwritten, and the first of several equal new keys wins.
+    assert((fm == FM{{1, "one"}, {2, "two"}, {3, "three"}, {4, "four"}, {5, "five"}, {6, "six"}, {7, "seven"}}));
+
+    fm.insert(v.begin(), v.begin());
+    assert(fm.size() == 7);
+    fm.insert({{8, "eight"}, {9, "nine"}});
+    assert(fm.size() == 9);
+    assert(fm.rbegin()->second == "nine");
+
+    // Move iterators move the new elements in.
+    std::vector<std::pair<int, std::string>> v2 = {{10, std::string(100, 'x')}, {0, std::string(100, 'y')}};
+    fm.insert(std::make_move_iterator(v2.begin()), std::make_move_iterator(v2.end()));
+    assert(fm.size() == 11);
+    assert(fm.begin()->second == std::string(100, 'y'));
+    assert(fm.at(10) == std::string(100, 'x'));
+
+    // Elements need only be convertible to value_type.
+    struct Entry {
+        int k;
+        const char *v;
+        operator FM::value_type() const { return {k, v}; }
+    };
+    const Entry entries[] = {{12, "twelve"}, {11, "eleven"}};
+    fm.insert(entries, entries + 2);
+    assert(fm.size() == 13 && fm.at(11) == "eleven");
+    FM fm2(entries, entries + 2);
+    assert(fm2.begin()->second == "eleven");
+
+    // A throw while converting the new elements leaves the existing ones alone.
+    struct ThrowingEntry {
+        int k;
+        operator FM::value_type() const {
+            if (k < 0) throw 42;
+            return {k, "new"};
+        }
+    };
+    const ThrowingEntry bad[] = {{20}, {21}, {-1}, {22}};
+    try {
+        fm.insert(bad, bad + 4);
+        assert(false);
+    } catch (int) {
+    }
+    assert(fm.size() == 13 && fm.count(20) == 0);
+    try {
+        fm.insert(stdext::sorted_unique, bad, bad + 4);
+        assert(false);
+    } catch (int) {
+    }
+    assert(fm.size() == 13 && fm.count(20) == 0 && fm.at(11) == "eleven");
+
+#if defined(__cpp_lib_memory_resource)
+    // The merge sets elements aside with the map's own allocator.
+    {
+        std::pmr::monotonic_buffer_resource mr;
+        std::pmr::polymorphic_allocator<int> a(&mr);
+        stdext::flat_map<int, int, std::less<>, std::pmr::vector<int>, std::pmr::vector<int>> pm({{2, 20}, {4, 40}}, a);
+        std::pmr::memory_resource *old_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        std::pair<int, int> more[] = {{3, 30}, {1, 10}, {5, 50}};
+        pm.insert(more, more + 3);
+        std::pmr::set_default_resource(old_default);
+        assert(pm.size() == 5 && pm.begin()->second == 10 && pm.at(3) == 30);
+    }
+#endif
+
+    // Compare a long sequence of bulk inserts against std::map.
+    std::mt19937 g(42);
+    std::map<int, int> expected;
+    stdext::flat_map<int, int, std::greater<int>, std::deque<int>> actual;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        for (int i = 0; i < 200; ++i) {
+            batch.emplace_back(int(g() % 1000), round * 1000 + i);
+        }
+        expected.insert(batch.begin(), batch.end());
+        actual.insert(batch.begin(), batch.end());
+        assert(actual.size() == expected.size());
+        assert(std::equal(actual.begin(), actual.end(), expected.rbegin(), expected.rend(), [](const auto& a, const auto& b) {
+            return a.first == b.first && a.second == b.second;
+        }));
+    }
+}
+
+static void SortedUniqueInsertTest()
+{
+    using FM = stdext::flat_map<int, std::string>;
+    FM fm{{2, "two"}, {4, "four"}, {6, "six"}};
+    std::vector<std::pair<int, std::string>> v = {{1, "one"}, {3, "three"}, {4, "FOUR"}, {5, "five"}, {7, "seven"}};
+    fm.insert(stdext::sorted_unique, v.begin(), v.end());
+    assert((fm == FM{{1, "one"}, {2, "two"}, {3, "three"}, {4, "four"}, {5, "five"}, {6, "six"}, {7, "seven"}}));
+
+    fm.insert(stdext::sorted_unique, {{8, "eight"}, {9, "nine"}});
+    assert(fm.size() == 9);
+    assert(fm.rbegin()->second == "nine");
+    fm.insert(stdext::sorted_unique, v.begin(), v.begin());
+    assert(fm.size() == 9);
+
+    std::mt19937 g(42);
+    std::map<int, int> expected;
+    stdext::flat_map<int, int, std::less<int>, std::deque<int>> actual;
+    for (int round = 0; round < 20; ++round) {
+        std::map<int, int> batch;
+        for (int i = 0; i < 200; ++i) {
+            batch.emplace(int(g() % 1000), round * 1000 + i);
+        }
+        expected.insert(batch.begin(), batch.end());
+        actual.insert(stdext::sorted_unique, batch.begin(), batch.end());
+        assert(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+            return a.first == b.first && a.second == b.second;
+        }));
+    }
+}
+
+template<class FM>
+static void LowerBoundTest()
+{
+    using K = typename FM::key_type;
+    std::mt19937 g(42);
+    for (int n : {0, 1, 2, 31, 32, 33, 1000}) {
+        FM fm;
+        for (int i = 0; i < n; ++i) {
+            fm.emplace(K(g() % 5000), i);
+        }
+        std::vector<K> v(fm.keys().begin(), fm.keys().end());
+        for (K k : v) {
+            for (K probe : {K(k - 1), k, K(k + 1)}) {
+                auto expected = std::lower_bound(v.begin(), v.end(), probe) - v.begin();
+                assert(fm.lower_bound(probe) - fm.begin() == expected);
+                assert(static_cast<const FM&>(fm).lower_bound(probe) - fm.cbegin() == expected);
+                assert(fm.count(probe) == (std::binary_search(v.begin(), v.end(), probe) ? 1u : 0u));
+            }
+        }
+        auto it = fm.try_emplace(K(10000), -1).first;
+        assert(it == fm.end() - 1);
+        assert(fm.lower_bound(K(0)) == fm.begin());
+    }
+}
+
 static void SortedUniqueConstructionTest()
 {
     auto a = stdext::sorted_unique;
@@ -686,7 +834,12 @@ void sg14_test::flat_map_test()
     AmbiguousEraseTest();
     ExtractDoesntSwapTest();
     MoveOperationsPilferOwnership();
+    RangeInsertTest();
+    LowerBoundTest<stdext::flat_map<int, int>>();
+    LowerBoundTest<stdext::flat_map<float, int, std::less<>>>();
+    LowerBoundTest<stdext::flat_map<unsigned, int, std::less<unsigned>, std::deque<unsigned>>>();
     SortedUniqueConstructionTest();
+    SortedUniqueInsertTest();
     TryEmplaceTest();
     VectorBoolSanityTest();
     DeductionGuideTests();
@@ -1,11 +1,14 @@
 #include "SG14_test.h"
 #include "flat_set.h"
+#include <algorithm>
 #include <assert.h>
 #include <deque>
 #include <functional>
 #if __has_include(<memory_resource>)
 #include <memory_resource>
 #endif
+#include <random>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -45,6 +48,43 @@ private:
 int InstrumentedWidget::move_ctors = 0;
 int InstrumentedWidget::copy_ctors = 0;
 
+struct CountdownLess {
+    static int compares_until_throw;
+    bool operator()(int a, int b) const {
+        if (compares_until_throw >= 0 && compares_until_throw-- == 0) throw 42;
+        return a < b;
+    }
+};
+int CountdownLess::compares_until_throw = -1;
+
+// Counts moves, and separately those of the even, non-negative keys that
+// the move-count test starts with.
+struct CountedKey {
+    static int moves, existing_moves;
+    static int copies_until_throw;
+    int k_;
+    CountedKey(int k) : k_(k) {}
+    CountedKey(CountedKey&& o) noexcept : k_(o.k_) { count_move(); }
+    CountedKey(const CountedKey& o) : k_(o.k_) {
+        if (copies_until_throw >= 0 && copies_until_throw-- == 0) throw 42;
+    }
+    CountedKey& operator=(CountedKey&& o) noexcept { k_ = o.k_; count_move(); return *this; }
+    CountedKey& operator=(const CountedKey&) = default;
+
+    friend bool operator<(const CountedKey& a, const CountedKey& b) {
+        return a.k_ < b.k_;
+    }
+
+private:
+    void count_move() {
+        moves += 1;
+        existing_moves += (k_ >= 0 && k_ % 2 == 0) ? 1 : 0;
+    }
+};
+int CountedKey::moves = 0;
+int CountedKey::existing_moves = 0;
+int CountedKey::copies_until_throw = -1;
+
 static void AmbiguousEraseTest()
 {
     stdext::flat_set<AmbiguousEraseWidget> fs;
@@ -210,6 +250,147 @@ static void MoveOperationsPilferOwnership()
     assert(InstrumentedWidget::copy_ctors == 0);
 }
 
+static void SortedUniqueInsertTest()
+{
+    using FS = stdext::flat_set<int>;
+    FS fs{2, 4, 6};
+    std::vector<int> v = {1, 3, 4, 5, 7};
+    fs.insert(stdext::sorted_unique, v.begin(), v.end());
+    assert((fs == FS{1, 2, 3, 4, 5, 6, 7}));
+
+    fs.insert(stdext::sorted_unique, {8, 9});
+    assert(fs.size() == 9);
+    assert(*fs.rbegin() == 9);
+    fs.insert(stdext::sorted_unique, v.begin(), v.begin());
+    assert(fs.size() == 9);
+
+    // Survivors are set aside and merged in from the back; duplicates are dropped.
+    using SS = stdext::flat_set<std::string>;
+    SS ss{std::string(40, 'b'), std::string(40, 'd')};
+    std::vector<std::string> sv = {std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c'), std::string(40, 'e')};
+    ss.insert(stdext::sorted_unique, sv.begin(), sv.end());
+    assert((ss == SS{std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c'), std::string(40, 'd'), std::string(40, 'e')}));
+
+#if defined(__cpp_lib_memory_resource)
+    // The temporary that holds the survivors is built with the set's own
+    // allocator, so nothing falls back to the default resource.
+    {
+        std::pmr::monotonic_buffer_resource mr;
+        stdext::flat_set<int, std::less<int>, std::pmr::vector<int>> pfs({2, 4}, std::pmr::polymorphic_allocator<int>(&mr));
+        std::pmr::memory_resource *old_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        pfs.insert(stdext::sorted_unique, {1, 3, 4, 5});
+        std::pmr::set_default_resource(old_default);
+        assert(pfs.size() == 5 && *pfs.begin() == 1);
+    }
+#endif
+
+    // Each existing element is moved at most once, and each new one that
+    // survives is moved twice: aside, and then into place.
+    {
+        using CS = stdext::flat_set<CountedKey>;
+        std::vector<CountedKey> base;
+        for (int i = 0; i < 2000; ++i) {
+            base.emplace_back(2 * i);
+        }
+        std::vector<CountedKey> front, interleaved, overlapping;
+        for (int i = 0; i < 10; ++i) {
+            front.emplace_back(i - 10);
+        }
+        for (int i = 0; i < 3000; ++i) {
+            interleaved.emplace_back(2 * i - 1);
+        }
+        for (int i = 0; i < 3000; ++i) {
+            overlapping.emplace_back(i);
+        }
+        for (const auto *batch : {&front, &interleaved, &overlapping}) {
+            std::vector<CountedKey> c;
+            c.reserve(base.size() + batch->size());
+            c.insert(c.end(), base.begin(), base.end());
+            CS cs(stdext::sorted_unique, std::move(c));
+            CountedKey::moves = 0;
+            CountedKey::existing_moves = 0;
+            cs.insert(stdext::sorted_unique, batch->begin(), batch->end());
+            assert(CountedKey::existing_moves <= int(base.size()));
+            assert(CountedKey::moves <= int(base.size() + 2 * batch->size()));
+            assert(std::is_sorted(cs.begin(), cs.end()));
+            assert(std::adjacent_find(cs.begin(), cs.end(), [](const CountedKey& a, const CountedKey& b) {
+                return !(a < b);
+            }) == cs.end());
+        }
+    }
+
+    // A throw while appending leaves the existing elements alone.
+    {
+        using CS = stdext::flat_set<CountedKey>;
+        CS cs{1, 3, 5};
+        std::vector<CountedKey> batch = {0, 2, 4, 6, 8};
+        CountedKey::copies_until_throw = 2;
+        try {
+            cs.insert(stdext::sorted_unique, batch.begin(), batch.end());
+            assert(false);
+        } catch (int) {
+        }
+        CountedKey::copies_until_throw = -1;
+        assert(cs.size() == 3);
+        assert(cs.begin()->k_ == 1 && cs.rbegin()->k_ == 5);
+    }
+
+    // So does a throw from the comparator before anything is merged.
+    {
+        using TS = stdext::flat_set<int, CountdownLess>;
+        for (int countdown : {0, 2}) {
+            TS ts{1, 3, 5};
+            CountdownLess::compares_until_throw = countdown;
+            try {
+                ts.insert(stdext::sorted_unique, {0, 2, 4});
+                assert(false);
+            } catch (int) {
+            }
+            CountdownLess::compares_until_throw = -1;
+            assert((ts == TS{1, 3, 5}));
+        }
+    }
+
+    std::mt19937 g(42);
+    std::set<int, std::greater<int>> expected;
+    stdext::flat_set<int, std::greater<int>, std::deque<int>> actual;
+    for (int round = 0; round < 20; ++round) {
+        std::set<int, std::greater<int>> batch;
+        for (int i = 0; i < 200; ++i) {
+            batch.insert(int(g() % 1000));
+        }
+        expected.insert(batch.begin(), batch.end());
+        actual.insert(stdext::sorted_unique, batch.begin(), batch.end());
+        assert(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+    }
+}
+
+template<class FS>
+static void LowerBoundTest()
+{
+    // Arithmetic keys with std::less take the branchless search; make sure
+    // it agrees with std::lower_bound around every element and both ends.
+    using K = typename FS::key_type;
+    std::mt19937 g(42);
+    for (int n : {0, 1, 2, 3, 31, 32, 33, 100, 1000}) {
+        FS fs;
+        for (int i = 0; i < n; ++i) {
+            fs.insert(K(g() % 5000) / K(2));
+        }
+        std::vector<K> v(fs.begin(), fs.end());
+        for (K k : v) {
+            for (K probe : {K(k - 1), k, K(k + 1)}) {
+                auto expected = std::lower_bound(v.begin(), v.end(), probe, fs.key_comp()) - v.begin();
+                assert(fs.lower_bound(probe) - fs.begin() == expected);
+                assert(static_cast<const FS&>(fs).lower_bound(probe) - fs.cbegin() == expected);
+                assert((fs.find(probe) != fs.end()) == std::binary_search(v.begin(), v.end(), probe, fs.key_comp()));
+            }
+        }
+        assert(fs.lower_bound(K(0)) == fs.begin());
+        assert(fs.lower_bound(K(10000)) == fs.end());
+    }
+}
+
 template<class FS>
 static void ConstructionTest()
 {
@@ -282,6 +463,11 @@ void sg14_test::flat_set_test()
     AmbiguousEraseTest();
     ExtractDoesntSwapTest();
     MoveOperationsPilferOwnership();
+    SortedUniqueInsertTest();
+    LowerBoundTest<stdext::flat_set<int>>();
+    LowerBoundTest<stdext::flat_set<short, std::less<>>>();
+    LowerBoundTest<stdext::flat_set<double>>();
+    LowerBoundTest<stdext::flat_set<long, std::less<long>, std::deque<long>>>();
     ThrowingSwapDoesntBreakInvariants();
     VectorBoolSanityTest();
     VectorBoolEvilComparatorTest();
@@ -1,6 +1,8 @@
 #include "SG14_test.h"
 #include "inplace_function.h"
 #include <cassert>
+#include <cstddef>
+#include <future>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -621,6 +623,246 @@ static void test_overloading_on_return_type()
     EXPECT_EQ(overloaded_function3([](int) { return nullptr; }), 2);
 }
 
+namespace {
+static int allocations, deallocations;
+
+template<class T>
+struct counting_allocator {
+    using value_type = T;
+    int* pool_uses = nullptr;
+    counting_allocator() = default;
+    explicit counting_allocator(int* uses) : pool_uses(uses) {}
+    template<class U> counting_allocator(const counting_allocator<U>& rhs) : pool_uses(rhs.pool_uses) {}
+    T* allocate(size_t n) {
+        ++allocations;
+        if (pool_uses) ++*pool_uses;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        ++deallocations;
+        std::allocator<T>().deallocate(p, n);
+    }
+    template<class U> bool operator==(const counting_allocator<U>& rhs) const { return pool_uses == rhs.pool_uses; }
+    template<class U> bool operator!=(const counting_allocator<U>& rhs) const { return pool_uses != rhs.pool_uses; }
+};
+
+struct ThrowingMove {
+    ThrowingMove() {}
+    ThrowingMove(const ThrowingMove&) {}
+    ThrowingMove(ThrowingMove&&) {}
+    int operator()(int x) const { return x + 1; }
+};
+} // anonymous namespace
+
+static void test_small_function()
+{
+    using SF = stdext::small_function<long(int), 16, counting_allocator<char>>;
+    static_assert(std::is_nothrow_move_constructible<SF>::value, "");
+    static_assert(std::is_copy_constructible<SF>::value, "");
+    allocations = deallocations = 0;
+    {
+        SF empty;
+        EXPECT_FALSE(bool(empty));
+        EXPECT_FALSE(empty.spilled());
+
+        long a = 1;
+        SF small = [a](int x) { return a + x; };
+        EXPECT_FALSE(small.spilled());
+        EXPECT_EQ(small(2), 3);
+        EXPECT_EQ(allocations, 0);
+
+        long b = 2, c = 3, d = 4;
+        SF big = [a, b, c, d](int x) { return a + b + c + d + x; };
+        EXPECT_TRUE(big.spilled());
+        EXPECT_EQ(big(5), 15);
+        EXPECT_EQ(allocations, 1);
+
+        // Moving a spilled function hands over the allocation.
+        SF moved = std::move(big);
+        EXPECT_TRUE(moved.spilled());
+        EXPECT_FALSE(bool(big));
+        EXPECT_EQ(moved(0), 10);
+        EXPECT_EQ(allocations, 1);
+
+        // Copying one makes a new allocation.
+        SF copy = moved;
+        EXPECT_TRUE(copy.spilled());
+        EXPECT_EQ(copy(1), 11);
+        EXPECT_EQ(allocations, 2);
+
+        swap(copy, small);
+        EXPECT_FALSE(copy.spilled());
+        EXPECT_TRUE(small.spilled());
+        EXPECT_EQ(copy(2), 3);
+        EXPECT_EQ(small(1), 11);
+
+        small = nullptr;
+        EXPECT_EQ(deallocations, 1);
+        copy = moved;
+        EXPECT_TRUE(copy.spilled());
+        EXPECT_EQ(allocations, 3);
+
+        // Callables whose move may throw are kept on the heap, so that
+        // moving a small_function stays noexcept.
+        SF throwing = ThrowingMove();
+        EXPECT_TRUE(throwing.spilled());
+        EXPECT_EQ(throwing(1), 2);
+
+        int pool_uses = 0;
+        SF pooled(std::allocator_arg, counting_allocator<char>(&pool_uses), [a, b, c, d](int) { return a + b + c + d; });
+        EXPECT_TRUE(pooled.spilled());
+        EXPECT_EQ(pooled(0), 10);
+        EXPECT_EQ(pool_uses, 1);
+        SF pooled_copy = pooled;
+        EXPECT_EQ(pool_uses, 2);
+    }
+    EXPECT_EQ(allocations, deallocations);
+
+    // A std::function too big for the buffer still works.
+    stdext::small_function<int(int), 8> sf = std::function<int(int)>([](int x) { return x * 2; });
+    EXPECT_EQ(sf.spilled(), (sizeof(std::function<int(int)>) > 8));
+    EXPECT_EQ(sf(21), 42);
+}
+
+static void test_inplace_unique_function()
+{
+    using IUF = stdext::inplace_unique_function<int(int)>;
+    static_assert(std::is_nothrow_default_constructible<IUF>::value, "");
+    static_assert(!std::is_copy_constructible<IUF>::value, "");
+    static_assert(!std::is_copy_assignable<IUF>::value, "");
+    static_assert(std::is_nothrow_move_constructible<IUF>::value, "");
+    static_assert(std::is_nothrow_move_assignable<IUF>::value, "");
+    static_assert(sizeof(stdext::inplace_function_detail::unique_vtable<int, int>) < sizeof(stdext::inplace_function_detail::vtable<int, int>), "");
+
+    IUF empty;
+    EXPECT_FALSE(bool(empty));
+    expected = 0; try { empty(1); } catch (std::bad_function_call&) { expected = 1; } EXPECT_EQ(expected, 1);
+
+    auto p = std::make_unique<int>(40);
+    IUF f = [p = std::move(p)](int x) { return *p + x; };
+    EXPECT_TRUE(bool(f));
+    EXPECT_EQ(f(2), 42);
+
+    IUF g = std::move(f);
+    EXPECT_FALSE(bool(f));
+    EXPECT_EQ(g(1), 41);
+
+    f = [q = std::make_unique<int>(7)](int x) { return *q * x; };
+    swap(f, g);
+    EXPECT_EQ(f(0), 40);
+    EXPECT_EQ(g(2), 14);
+
+    g = std::move(f);
+    EXPECT_EQ(g(0), 40);
+    g = nullptr;
+    EXPECT_TRUE(g == nullptr);
+
+    // Bigger buffers accept smaller ones.
+    stdext::inplace_unique_function<int(int), 64> big = std::move(f);
+    EXPECT_TRUE(f == nullptr);
+
+    // A copyable inplace_function can be stored too.
+    stdext::inplace_function<int(int)> copyable = [](int x) { return x + 1; };
+    stdext::inplace_unique_function<int(int), 64> wrapped = copyable;
+    EXPECT_EQ(wrapped(1), 2);
+
+    std::promise<int> promise;
+    std::future<int> future = promise.get_future();
+    stdext::inplace_unique_function<void(int)> fulfil = [pr = std::move(promise)](int x) mutable { pr.set_value(x); };
+    fulfil(5);
+    EXPECT_EQ(future.get(), 5);
+
+    // Destroying the function destroys the capture.
+    std::weak_ptr<int> watch;
+    {
+        auto shared = std::make_shared<int>(1);
+        watch = shared;
+        IUF holder = [shared = std::move(shared)](int) { return *shared; };
+        EXPECT_FALSE(watch.expired());
+    }
+    EXPECT_TRUE(watch.expired());
+}
+
+static void test_trivially_copyable_fast_path()
+{
+    using namespace stdext::inplace_function_detail;
+    auto pod = [a = 1, b = 2.0](int x) { return a + b + x; };
+    std::string str = "abc";
+    auto nonpod = [str](int x) { return str.size() + x; };
+    static const vtable<double, int> pod_vt{wrapper<decltype(pod)>{}};
+    static const vtable<double, int> nonpod_vt{wrapper<decltype(nonpod)>{}};
+    EXPECT_TRUE(pod_vt.trivially_copyable);
+    EXPECT_FALSE(nonpod_vt.trivially_copyable);
+    EXPECT_FALSE((empty_vtable<double, int>.trivially_copyable));
+    EXPECT_TRUE((empty_vtable<double, int>.is_empty));
+    EXPECT_FALSE(pod_vt.is_empty);
+
+    // Copies, moves and swaps give the same results on either path,
+    // including mixed swaps and conversions to a bigger buffer.
+    using IPF = stdext::inplace_function<double(int), 48>;
+    IPF p = pod;
+    IPF n = nonpod;
+    IPF p2 = p;
+    IPF n2 = n;
+    EXPECT_EQ(p2(1), 4.0);
+    EXPECT_EQ(n2(1), 4.0);
+    swap(p2, n2);
+    EXPECT_EQ(p2(2), 5.0);
+    EXPECT_EQ(n2(3), 6.0);
+    IPF p3 = std::move(n2);
+    EXPECT_FALSE(bool(n2));
+    EXPECT_EQ(p3(0), 3.0);
+    stdext::inplace_function<double(int), 96> wide = p3;
+    stdext::inplace_function<double(int), 96> wide2 = std::move(p3);
+    EXPECT_EQ(wide(0), 3.0);
+    EXPECT_EQ(wide2(0), 3.0);
+    n = p;
+    EXPECT_EQ(n(0), 3.0);
+
+    stdext::inplace_unique_function<double(int)> u = pod;
+    stdext::inplace_unique_function<double(int), 64> u2 = std::move(u);
+    EXPECT_EQ(u2(1), 4.0);
+}
+
+static void test_inline_invoker()
+{
+    using Inline = stdext::inplace_function<int(int), 16, alignof(void*), true>;
+    using Plain = stdext::inplace_function<int(int), 16, alignof(void*)>;
+    static_assert(sizeof(Inline) == sizeof(Plain) + sizeof(void*), "");
+
+    Inline empty;
+    EXPECT_FALSE(bool(empty));
+    expected = 0; try { empty(1); } catch (std::bad_function_call&) { expected = 1; } EXPECT_EQ(expected, 1);
+
+    auto three = std::make_shared<int>(3);
+    Inline f = [](int x) { return x + 1; };
+    Inline g = [three](int x) { return *three + x; };
+    EXPECT_EQ(f(1), 2);
+    EXPECT_EQ(g(1), 4);
+
+    // The cached invoker follows the vtable through every operation.
+    swap(f, g);
+    EXPECT_EQ(f(1), 4);
+    EXPECT_EQ(g(1), 2);
+    Inline h = std::move(f);
+    EXPECT_FALSE(bool(f));
+    expected = 0; try { f(1); } catch (std::bad_function_call&) { expected = 1; } EXPECT_EQ(expected, 1);
+    EXPECT_EQ(h(0), 3);
+    f = h;
+    EXPECT_EQ(f(0), 3);
+    f = nullptr;
+    expected = 0; try { f(1); } catch (std::bad_function_call&) { expected = 1; } EXPECT_EQ(expected, 1);
+
+    // Conversions in both directions between the two layouts.
+    Plain p = h;
+    EXPECT_EQ(p(1), 4);
+    Inline back = std::move(p);
+    EXPECT_FALSE(bool(p));
+    EXPECT_EQ(back(2), 5);
+    stdext::inplace_function<int(int), 32, alignof(void*), true> wider = back;
+    EXPECT_EQ(wider(3), 6);
+}
+
 void sg14_test::inplace_function_test()
 {
     // first set of tests (from Optiver)
@@ -713,6 +955,10 @@ void sg14_test::inplace_function_test()
     test_overloading_on_arity();
     test_overloading_on_parameter_type();
     test_overloading_on_return_type();
+    test_small_function();
+    test_inplace_unique_function();
+    test_trivially_copyable_fast_path();
+    test_inline_invoker();
 }
 
 #ifdef TEST_MAIN
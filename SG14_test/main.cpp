@@ -8,9 +8,11 @@
 
 int main(int, char *[])
 {
+    sg14_test::eytzinger_set_test();
     sg14_test::flat_map_test();
     sg14_test::flat_set_test();
     sg14_test::inplace_function_test();
+    sg14_test::paged_vector_test();
     sg14_test::plf_colony_test();
     sg14_test::ring_test();
     sg14_test::slot_map_test();
@@ -0,0 +1,169 @@
+#include "SG14_test.h"
+#include "paged_vector.h"
+#include "slot_map.h"
+#include <algorithm>
+#include <assert.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+static void BasicTest()
+{
+    using PV = stdext::basic_paged_vector<int, 64>;
+    static_assert(PV::page_size == 16, "64 bytes of int");
+    static_assert(stdext::basic_paged_vector<char[3], 64>::page_size == 16, "rounded down to a power of two");
+    static_assert(stdext::basic_paged_vector<char[100], 64>::page_size == 1, "at least one element per page");
+
+    PV pv;
+    assert(pv.empty() && pv.capacity() == 0);
+    for (int i = 0; i < 100; ++i) {
+        pv.push_back(i);
+    }
+    assert(pv.size() == 100);
+    assert(pv.capacity() == 112);
+    assert(pv.front() == 0 && pv.back() == 99);
+    for (int i = 0; i < 100; ++i) {
+        assert(pv[i] == i);
+    }
+    assert(pv.end() - pv.begin() == 100);
+    assert(*(pv.begin() + 37) == 37);
+    assert(pv.begin()[63] == 63);
+    assert(*std::prev(pv.end()) == 99);
+    assert((std::vector<int>(pv.rbegin(), pv.rbegin() + 3) == std::vector<int>{99, 98, 97}));
+    try { (void)pv.at(100); assert(false); } catch (const std::out_of_range&) {}
+
+    // Random-access iterators work with the standard algorithms.
+    std::reverse(pv.begin(), pv.end());
+    assert(pv.front() == 99 && pv.back() == 0);
+    std::sort(pv.begin(), pv.end());
+    assert(std::is_sorted(pv.cbegin(), pv.cend()));
+    PV::const_iterator cit = pv.begin();
+    assert(cit == pv.cbegin());
+
+    // Popping keeps the pages, and shrink_to_fit releases them.
+    while (pv.size() > 20) {
+        pv.pop_back();
+    }
+    assert(pv.capacity() == 112);
+    pv.shrink_to_fit();
+    assert(pv.capacity() == 32);
+    pv.clear();
+    assert(pv.empty() && pv.capacity() == 32);
+    pv.shrink_to_fit();
+    assert(pv.capacity() == 0);
+
+    pv.reserve(40);
+    assert(pv.capacity() == 48);
+    pv.reserve(10);
+    assert(pv.capacity() == 48);
+}
+
+static void StableAddressTest()
+{
+    stdext::basic_paged_vector<std::string, 256> pv;
+    pv.emplace_back("first");
+    const std::string *first = &pv.front();
+    const char *first_chars = first->data();
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 1000; ++i) {
+        addresses.push_back(&pv.emplace_back(std::to_string(i)));
+    }
+    assert(&pv.front() == first);
+    assert(pv.front().data() == first_chars);
+    for (int i = 0; i < 1000; ++i) {
+        assert(&pv[i + 1] == addresses[i]);
+        assert(*addresses[i] == std::to_string(i));
+    }
+}
+
+static void CopyMoveSwapTest()
+{
+    stdext::paged_vector<std::unique_ptr<int>> a;
+    for (int i = 0; i < 2000; ++i) {
+        a.emplace_back(std::make_unique<int>(i));
+    }
+    const int *p = a[1500].get();
+    auto b = std::move(a);
+    assert(a.empty() && b.size() == 2000);
+    assert(b[1500].get() == p);
+
+    stdext::paged_vector<std::unique_ptr<int>> c;
+    c.emplace_back(std::make_unique<int>(-1));
+    swap(b, c);
+    assert(c.size() == 2000 && b.size() == 1);
+    assert(*b[0] == -1 && c[1500].get() == p);
+    c = std::move(b);
+    assert(c.size() == 1 && *c[0] == -1);
+
+    stdext::paged_vector<int> d;
+    for (int i = 0; i < 5000; ++i) {
+        d.push_back(i);
+    }
+    auto e = d;
+    assert(e.size() == d.size() && std::equal(e.begin(), e.end(), d.begin()));
+    e.pop_back();
+    d = e;
+    assert(d.size() == 4999 && d.back() == 4998);
+}
+
+struct ThrowsOnConstruct {
+    explicit ThrowsOnConstruct(bool do_throw) { if (do_throw) throw 42; }
+};
+
+static void ExceptionTest()
+{
+    stdext::basic_paged_vector<ThrowsOnConstruct, 16> pv;
+    for (int i = 0; i < 16; ++i) {
+        pv.emplace_back(false);
+    }
+    try { pv.emplace_back(true); assert(false); } catch (int) {}
+    assert(pv.size() == 16);
+    pv.emplace_back(false);
+    assert(pv.size() == 17);
+}
+
+static void SlotMapTest()
+{
+    stdext::slot_map<std::string, std::pair<unsigned, unsigned>, stdext::paged_vector> sm;
+    sm.reserve_slots(1000);
+    assert(sm.slot_count() == 1000);
+    auto k = sm.insert("stable");
+    const std::string *p = &sm[k];
+    std::vector<std::pair<unsigned, unsigned>> keys;
+    for (int i = 0; i < 10000; ++i) {
+        keys.push_back(sm.insert(std::to_string(i)));
+    }
+    assert(&sm[k] == p);
+    for (int i = 0; i < 10000; i += 2) {
+        sm.erase(keys[i]);
+    }
+    assert(sm.size() == 5001);
+    assert(&sm[k] == p);
+    assert(sm.at(keys[9999]) == "9999");
+
+    // sort builds its scratch arrays as paged_vectors, too.
+    sm.sort();
+    assert(std::is_sorted(sm.begin(), sm.end()));
+    assert(sm.at(keys[9999]) == "9999" && sm[k] == "stable");
+}
+
+} // namespace
+
+void sg14_test::paged_vector_test()
+{
+    BasicTest();
+    StableAddressTest();
+    CopyMoveSwapTest();
+    ExceptionTest();
+    SlotMapTest();
+}
+
+#ifdef TEST_MAIN
+int main()
+{
+    sg14_test::paged_vector_test();
+}
+#endif
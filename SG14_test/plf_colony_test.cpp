@@ -173,6 +173,38 @@ namespace
 		small_struct_non_trivial(const int num) : number(num) {};
 		~small_struct_non_trivial() { ++global_counter; };
 	};
+
+
+
+	int live_key_count = 0;
+
+	// Sort key which counts its live instances, so that a sort_by_key which throws part-way can be checked for leaks:
+	struct counted_key
+	{
+		int value;
+
+		counted_key(const int num) : value(num) { ++live_key_count; }
+		counted_key(const counted_key &source) : value(source.value) { ++live_key_count; }
+		~counted_key() { --live_key_count; }
+		bool operator < (const counted_key &rh) const { return value < rh.value; }
+	};
+
+
+
+	struct throwing_key_extractor
+	{
+		int *calls;
+
+		counted_key operator() (const int value) const
+		{
+			if (++*calls == 50)
+			{
+				throw 50;
+			}
+
+			return counted_key(value);
+		}
+	};
 }
 
 
@@ -1213,11 +1245,226 @@ void plf_colony_test()
 			}
 
 			failpass("Greater-than sort test", sorted);
+
+			#ifdef PLF_TEST_TYPE_TRAITS_SUPPORT
+				// Signed integral keys take the radix sort; erase some elements first so that it has to skip them:
+				const int total_before = std::accumulate(i_colony.begin(), i_colony.end(), 0);
+
+				for (colony<int>::iterator current = i_colony.begin(); current != i_colony.end(); ++current)
+				{
+					*current -= 32768;
+				}
+
+				for (colony<int>::iterator current = i_colony.begin(); current != i_colony.end();)
+				{
+					if ((*current & 7) == 0)
+					{
+						current = i_colony.erase(current);
+					}
+					else
+					{
+						++current;
+					}
+				}
+
+				const int total_after_erase = std::accumulate(i_colony.begin(), i_colony.end(), 0);
+				i_colony.sort_by_key([](int value) { return value; });
+				failpass("Radix sort_by_key test", std::is_sorted(i_colony.begin(), i_colony.end()));
+				failpass("Radix sort_by_key keeps elements test", std::accumulate(i_colony.begin(), i_colony.end(), 0) == total_after_erase && total_after_erase != total_before);
+
+				i_colony.sort_by_key([](int value) { return static_cast<unsigned char>(value); });
+				sorted = true;
+				previous = 0;
+
+				for (colony<int>::iterator current = i_colony.begin(); current != i_colony.end(); ++current)
+				{
+					if (previous > (*current & 255))
+					{
+						sorted = false;
+						break;
+					}
+
+					previous = *current & 255;
+				}
+
+				failpass("Single-digit radix sort_by_key test", sorted);
+
+				i_colony.sort_by_key([](int value) { return -static_cast<double>(value); });
+				failpass("Floating-point sort_by_key test", std::is_sorted(i_colony.begin(), i_colony.end(), std::greater<int>()));
+
+				colony<std::vector<int> > v_colony;
+
+				for (int temp = 0; temp != 100; ++temp)
+				{
+					v_colony.insert(std::vector<int>(static_cast<size_t>((temp * 37) % 100)));
+				}
+
+				v_colony.sort_by_key([](const std::vector<int> &value) { return value.size(); });
+				sorted = true;
+				size_t previous_size = 0;
+
+				for (colony<std::vector<int> >::iterator current = v_colony.begin(); current != v_colony.end(); ++current)
+				{
+					if (previous_size > current->size())
+					{
+						sorted = false;
+						break;
+					}
+
+					previous_size = current->size();
+				}
+
+				failpass("Non-trivially-copyable sort_by_key test", sorted && v_colony.size() == 100);
+
+				// A throwing key extractor must leave the colony as it was and destroy the keys already extracted:
+				const int total_before_throw = std::accumulate(i_colony.begin(), i_colony.end(), 0);
+				const int first_before_throw = *i_colony.begin();
+				int extract_calls = 0;
+				bool thrown = false;
+				throwing_key_extractor extractor = { &extract_calls };
+
+				try
+				{
+					i_colony.sort_by_key(extractor);
+				}
+				catch (int)
+				{
+					thrown = true;
+				}
+
+				failpass("Throwing sort_by_key test", thrown && live_key_count == 0 && std::accumulate(i_colony.begin(), i_colony.end(), 0) == total_before_throw && *i_colony.begin() == first_before_throw);
+			#endif
+
+			#if defined(PLF_COLONY_PARALLEL_SORT) && __cplusplus >= 201703L
+				i_colony.sort(std::execution::par_unseq, std::greater<int>());
+				failpass("Parallel sort test", std::is_sorted(i_colony.begin(), i_colony.end(), std::greater<int>()));
+			#endif
 		}
 
 
 
 
+		#ifdef PLF_TEST_TYPE_TRAITS_SUPPORT
+		{
+			title2("Group traversal tests");
+
+			colony<int> i_colony(plf::colony_limits(10, 10));
+			unsigned int number_of_groups = 0;
+
+			i_colony.for_each_group([&number_of_groups](colony<int>::group_view) { ++number_of_groups; });
+			failpass("Empty for_each_group test", number_of_groups == 0);
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_colony.insert(temp);
+			}
+
+			// Erase a whole group's worth from the middle, plus a scattering of other elements, so that the views have to skip both:
+			for (colony<int>::iterator current = i_colony.begin(); current != i_colony.end();)
+			{
+				if ((*current >= 500 && *current < 520) || *current % 7 == 0)
+				{
+					current = i_colony.erase(current);
+				}
+				else
+				{
+					++current;
+				}
+			}
+
+			const int total = std::accumulate(i_colony.begin(), i_colony.end(), 0);
+			int group_total = 0;
+			colony<int>::size_type group_sizes = 0;
+			bool views_consistent = true;
+			std::vector<int> visited;
+
+			i_colony.for_each_group([&](colony<int>::group_view view)
+			{
+				++number_of_groups;
+				group_sizes += view.size();
+				views_consistent = views_consistent && view.size() != 0 && view.size() <= view.capacity() && static_cast<colony<int>::size_type>(std::distance(view.begin(), view.end())) == view.size();
+
+				for (colony<int>::iterator current = view.begin(); current != view.end(); ++current)
+				{
+					group_total += *current;
+					visited.push_back(*current);
+				}
+			});
+
+			failpass("for_each_group covers every group test", number_of_groups == 98 && group_sizes == i_colony.size());
+			failpass("for_each_group view consistency test", views_consistent);
+			failpass("for_each_group visits every element in order test", group_total == total && std::equal(visited.begin(), visited.end(), i_colony.begin()));
+
+			const colony<int> &const_colony = i_colony;
+			group_sizes = 0;
+			const_colony.for_each_group([&group_sizes](colony<int>::const_group_view view) { group_sizes += view.size(); });
+			failpass("Const for_each_group test", group_sizes == i_colony.size());
+
+			visited.clear();
+			i_colony.visit([&visited](int &value) { visited.push_back(value); });
+			failpass("visit test", visited.size() == i_colony.size() && std::equal(visited.begin(), visited.end(), i_colony.begin()));
+
+			int even_total = 0;
+			const_colony.visit_if([](const int &value) { return value % 2 == 0; }, [&even_total](const int &value) { even_total += value; });
+			failpass("Const visit_if test", even_total != 0 && even_total == std::accumulate(i_colony.begin(), i_colony.end(), 0, [](int sum, int value) { return (value % 2 == 0) ? sum + value : sum; }));
+
+			// Random erasure and reinsertion, so that runs start and end at group boundaries, at last_endpoint and at reused free-list locations:
+			bool visit_matches = true;
+
+			for (unsigned int round = 0; round != 50 && visit_matches; ++round)
+			{
+				for (colony<int>::iterator current = i_colony.begin(); current != i_colony.end();)
+				{
+					if ((plf::rand() & 3) == 0)
+					{
+						current = i_colony.erase(current);
+					}
+					else
+					{
+						++current;
+					}
+				}
+
+				for (unsigned int temp = plf::rand() & 255; temp != 0; --temp)
+				{
+					i_colony.insert(static_cast<int>(plf::rand() & 65535));
+				}
+
+				visited.clear();
+				i_colony.visit([&visited](int &value) { visited.push_back(value); });
+				visit_matches = visited.size() == i_colony.size() && std::equal(visited.begin(), visited.end(), i_colony.begin());
+			}
+
+			failpass("visit after random erasure and insertion test", visit_matches);
+
+			// Element types smaller than two skipfield nodes are stored padded:
+			colony<char> c_colony;
+
+			for (int temp = 0; temp != 300; ++temp)
+			{
+				c_colony.insert(static_cast<char>(temp % 100));
+			}
+
+			for (colony<char>::iterator current = c_colony.begin(); current != c_colony.end();)
+			{
+				current = (*current % 3 == 0) ? c_colony.erase(current) : ++current;
+			}
+
+			int char_total = 0;
+			c_colony.visit([&char_total](char value) { char_total += value; });
+			failpass("Padded element visit test", char_total == std::accumulate(c_colony.begin(), c_colony.end(), 0));
+
+			#if defined(PLF_COLONY_PARALLEL_SORT) && __cplusplus >= 201703L
+				const int total_before_doubling = std::accumulate(i_colony.begin(), i_colony.end(), 0);
+				i_colony.for_each(std::execution::par, [](int &value) { value *= 2; });
+				failpass("Parallel for_each test", std::accumulate(i_colony.begin(), i_colony.end(), 0) == total_before_doubling * 2);
+			#endif
+		}
+		#endif
+
+
+
+
 		{
 			title2("Different insertion-style tests");
 
@@ -1962,6 +2209,132 @@ void plf_colony_test()
 
 			failpass("erase_if test",	static_cast<int>(i_colony.size()) == 500);
 
+			#ifdef PLF_TEST_TYPE_TRAITS_SUPPORT
+				// Member erase_if against a vector holding the same elements. Each round erases at random, merging with skipblocks left by earlier rounds and by erase(), and the colony is then checked forwards and backwards, and by reusing the free lists:
+				colony<int> i_colony3(plf::colony_limits(10, 50));
+				std::vector<int> expected;
+				bool matches = true;
+
+				for (int count = 0; count != 2000; ++count)
+				{
+					i_colony3.insert(count);
+					expected.push_back(count);
+				}
+
+				for (unsigned int round = 0; round != 20 && matches; ++round)
+				{
+					const unsigned int mask = (round % 4 == 3) ? 0u : 1u + (round % 3);
+
+					for (colony<int>::iterator current = i_colony3.begin(); current != i_colony3.end();)
+					{
+						if ((plf::rand() & 15) == 0)
+						{
+							expected.erase(std::find(expected.begin(), expected.end(), *current));
+							current = i_colony3.erase(current);
+						}
+						else
+						{
+							++current;
+						}
+					}
+
+					std::vector<int> to_erase;
+
+					for (std::vector<int>::iterator current = expected.begin(); current != expected.end(); ++current)
+					{
+						if ((plf::rand() & mask) == 0 || (*current >= 600 && *current < 900))
+						{
+							*current = -*current - 1;
+						}
+					}
+
+					for (colony<int>::iterator current = i_colony3.begin(); current != i_colony3.end(); ++current)
+					{
+						if (std::find(expected.begin(), expected.end(), -*current - 1) != expected.end())
+						{
+							*current = -*current - 1;
+						}
+					}
+
+					const colony<int>::size_type number_erased = i_colony3.erase_if([](int value) { return value < 0; });
+					const std::vector<int>::size_type original_size = expected.size();
+					expected.erase(std::remove_if(expected.begin(), expected.end(), [](int value) { return value < 0; }), expected.end());
+
+					// Insertions reuse erased locations, so only the first round preserves order relative to expected:
+					std::vector<int> forwards(i_colony3.begin(), i_colony3.end()), backwards;
+
+					for (colony<int>::iterator current = i_colony3.end(); current != i_colony3.begin();)
+					{
+						backwards.push_back(*--current);
+					}
+
+					std::vector<int> sorted_expected(expected);
+					std::sort(sorted_expected.begin(), sorted_expected.end());
+
+					matches = number_erased == original_size - expected.size() && i_colony3.size() == expected.size() &&
+						std::equal(backwards.rbegin(), backwards.rend(), forwards.begin()) && (round != 0 || forwards == expected);
+
+					std::sort(forwards.begin(), forwards.end());
+					matches = matches && forwards == sorted_expected && static_cast<std::vector<int>::size_type>(std::distance(i_colony3.begin(), i_colony3.end())) == expected.size();
+
+					for (unsigned int temp = plf::rand() & 127; temp != 0; --temp)
+					{
+						const int value = 2000 + static_cast<int>(round * 128 + temp);
+						i_colony3.insert(value);
+						expected.push_back(value);
+					}
+
+					matches = matches && i_colony3.size() == expected.size() && std::accumulate(i_colony3.begin(), i_colony3.end(), 0) == std::accumulate(expected.begin(), expected.end(), 0);
+				}
+
+				failpass("Member erase_if matches erase test", matches);
+
+				i_colony3.erase_if([](int) { return false; });
+				failpass("Member erase_if no-op test", i_colony3.size() == expected.size());
+
+				failpass("Member erase_if everything test", i_colony3.erase_if([](int) { return true; }) == expected.size() && i_colony3.empty() && i_colony3.begin() == i_colony3.end());
+
+				i_colony3.insert(100, 7);
+				failpass("Insert after erase_if everything test", i_colony3.size() == 100 && std::accumulate(i_colony3.begin(), i_colony3.end(), 0) == 700);
+
+				i_colony3.clear();
+				failpass("Member erase_if on empty colony test", i_colony3.erase_if([](int) { return true; }) == 0);
+
+				for (int count = 0; count != 200; ++count)
+				{
+					i_colony3.insert(count);
+				}
+
+				struct throwing_predicate
+				{
+					int calls;
+					bool operator() (int value)
+					{
+						if (++calls == 150)
+						{
+							throw value;
+						}
+
+						return value % 2 == 0;
+					}
+				};
+
+				throwing_predicate predicate = {0};
+				bool thrown = false;
+
+				try
+				{
+					i_colony3.erase_if(std::ref(predicate));
+				}
+				catch (int)
+				{
+					thrown = true;
+				}
+
+				int odd_count = 0;
+				i_colony3.visit([&odd_count](int value) { odd_count += value % 2; });
+				failpass("Member erase_if throwing predicate test", thrown && i_colony3.size() == 125 && odd_count == 100 && static_cast<colony<int>::size_type>(std::distance(i_colony3.begin(), i_colony3.end())) == 125);
+			#endif
 		}
 
 		{
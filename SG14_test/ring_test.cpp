@@ -1,10 +1,16 @@
 #include "SG14_test.h"
 
 #include "ring.h"
+#include "mirrored_buffer.h"
 
 #include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 static void basic_test()
@@ -165,6 +171,417 @@ static void reverse_iterator_test()
     static_assert(std::is_same<decltype(c.crend()), decltype(r)::const_reverse_iterator>::value, "");
 }
 
+static void segments_test()
+{
+    std::array<int, 5> A = {};
+    sg14::ring_span<int> r(A.begin(), A.end());
+
+    auto w = r.write_segments(3);
+    assert(w.size() == 3 && w.first.size == 3 && w.second.size == 0);
+    std::iota(w.first.begin(), w.first.end(), 1);
+    r.commit(3);
+    assert((std::vector<int>(r.begin(), r.end()) == std::vector<int>{1, 2, 3}));
+
+    const auto& cr = r;
+    auto rd = cr.read_segments(2);
+    static_assert(std::is_same<decltype(rd), sg14::ring_segments<const int>>::value, "");
+    assert(rd.first.size == 2 && rd.first.data[0] == 1 && rd.first.data[1] == 2 && rd.second.size == 0);
+    r.consume(2);
+    assert(r.size() == 1 && r.front() == 3);
+
+    // The next four slots wrap around the end of the storage.
+    w = r.write_segments(4);
+    assert(w.first.data == &A[3] && w.first.size == 2);
+    assert(w.second.data == &A[0] && w.second.size == 2);
+    std::iota(w.first.begin(), w.first.end(), 4);
+    std::iota(w.second.begin(), w.second.end(), 6);
+    r.commit(4);
+    assert(r.full());
+    assert((std::vector<int>(r.begin(), r.end()) == std::vector<int>{3, 4, 5, 6, 7}));
+
+    auto rw = r.read_segments(5);
+    assert(rw.first.size == 3 && rw.second.size == 2);
+    assert(std::accumulate(rw.first.begin(), rw.first.end(), 0) + std::accumulate(rw.second.begin(), rw.second.end(), 0) == 25);
+
+    // Committing into a full ring overwrites the front, as push_back does.
+    w = r.write_segments(2);
+    w.first.data[0] = 8;
+    w.first.data[1] = 9;
+    r.commit(2);
+    assert((std::vector<int>(r.begin(), r.end()) == std::vector<int>{5, 6, 7, 8, 9}));
+    r.consume(5);
+    assert(r.empty());
+    r.push_back(10);
+    assert(r.front() == 10 && &r.front() == &A[4]);
+
+    std::vector<std::string> v(3);
+    sg14::ring_span<std::string, sg14::copy_popper<std::string>> s(v.begin(), v.end(), {"popped"});
+    s.emplace_back("quick");
+    s.emplace_back("brown");
+    s.consume(2);
+    assert((v == std::vector<std::string>{"popped", "popped", ""}));
+}
+
+static void pow2_test()
+{
+    std::array<int, 4> A;
+    sg14::pow2_ring_span<int> r(A.begin(), A.end());
+    assert(r.empty() && r.capacity() == 4);
+    r.push_back(1);
+    r.emplace_back(2);
+    assert(r.size() == 2 && r.front() == 1 && r.back() == 2);
+    for (int i = 3; i <= 6; ++i) {
+        r.push_back(i);
+    }
+    assert(r.full());
+    assert((std::vector<int>(r.begin(), r.end()) == std::vector<int>{3, 4, 5, 6}));
+    assert((std::vector<int>(r.rbegin(), r.rend()) == std::vector<int>{6, 5, 4, 3}));
+    assert(r.end() - r.begin() == 4);
+    assert(r.pop_front() == 3);
+    assert(r.size() == 3 && r.front() == 4);
+
+    auto w = r.write_segments(1);
+    assert(w.first.data == &A[2] && w.first.size == 1);
+    w.first.data[0] = 7;
+    r.commit(1);
+    auto rd = r.read_segments(4);
+    assert(rd.first.size == 1 && rd.second.size == 3);
+    r.consume(4);
+    assert(r.empty());
+
+    // Behaves like ring_span under any mix of operations.
+    std::array<int, 8> B;
+    std::array<int, 8> C;
+    sg14::pow2_ring_span<int> p(B.begin(), B.end());
+    sg14::ring_span<int> q(C.begin(), C.end());
+    for (int i = 0; i < 1000; ++i) {
+        int op = (i * 7919) % 5;
+        if (op < 3) {
+            p.push_back(i);
+            q.push_back(i);
+        } else if (op == 3 && !q.empty()) {
+            assert(p.pop_front() == q.pop_front());
+        } else {
+            size_t n = static_cast<size_t>(i % 4);
+            auto pw = p.write_segments(n);
+            auto qw = q.write_segments(n);
+            assert(pw.first.size == qw.first.size && pw.second.size == qw.second.size);
+            std::fill(pw.first.begin(), pw.first.end(), i);
+            std::fill(pw.second.begin(), pw.second.end(), i);
+            std::fill(qw.first.begin(), qw.first.end(), i);
+            std::fill(qw.second.begin(), qw.second.end(), i);
+            p.commit(n);
+            q.commit(n);
+        }
+        assert(p.size() == q.size());
+        assert(std::equal(p.begin(), p.end(), q.begin(), q.end()));
+    }
+
+    std::array<int, 4> D;
+    sg14::pow2_ring_span<int> s(D.begin(), D.end());
+    s.push_back(1);
+    swap(r, s);
+    assert(r.size() == 1 && s.empty());
+}
+
+namespace {
+struct counted {
+    static int alive;
+    int value;
+    explicit counted(int v) : value(v) { ++alive; }
+    counted(const counted& rhs) : value(rhs.value) { ++alive; }
+    counted(counted&& rhs) noexcept : value(rhs.value) { ++alive; }
+    counted& operator=(const counted&) = delete;
+    ~counted() { --alive; }
+};
+int counted::alive = 0;
+} // namespace
+
+static void static_ring_test()
+{
+    {
+        // No default constructor and no assignment: every element is
+        // constructed in place and only pushed elements are alive.
+        sg14::static_ring<counted, 3> r;
+        static_assert(decltype(r)::capacity() == 3, "");
+        assert(r.empty() && counted::alive == 0);
+        r.emplace_back(1);
+        r.push_back(counted(2));
+        assert(counted::alive == 2 && r.size() == 2);
+        assert(r.front().value == 1 && r.back().value == 2);
+
+        r.emplace_back(3);
+        r.emplace_back(4);
+        assert(r.full() && counted::alive == 3);
+        assert(r.front().value == 2 && r.back().value == 4);
+
+        // Pushing a copy of the front of a full ring.
+        r.push_back(r.front());
+        assert(r.front().value == 3 && r.back().value == 2);
+
+        counted c = r.pop_front();
+        assert(c.value == 3 && r.size() == 2 && counted::alive == 3);
+
+        std::vector<int> values;
+        for (const counted& x : r) {
+            values.push_back(x.value);
+        }
+        assert((values == std::vector<int>{4, 2}));
+
+        sg14::static_ring<counted, 3> copy(r);
+        assert(counted::alive == 5 && copy.front().value == 4 && copy.back().value == 2);
+        sg14::static_ring<counted, 3> moved(std::move(copy));
+        moved.emplace_back(5);
+        assert(moved.size() == 3 && moved.back().value == 5);
+        r = moved;
+        assert(r.size() == 3 && r.front().value == 4);
+        r.clear();
+        assert(r.empty());
+        r = std::move(moved);
+        assert(r.size() == 3);
+    }
+    assert(counted::alive == 0);
+
+    sg14::static_ring<std::string, 4> s;
+    for (int i = 0; i < 10; ++i) {
+        s.push_back(std::to_string(i));
+    }
+    assert((std::vector<std::string>(s.begin(), s.end()) == std::vector<std::string>{"6", "7", "8", "9"}));
+    assert((std::vector<std::string>(s.rbegin(), s.rend()) == std::vector<std::string>{"9", "8", "7", "6"}));
+}
+
+static void mirrored_buffer_test()
+{
+#if defined(SG14_HAS_MIRRORED_BUFFER)
+    sg14::mirrored_buffer<char> buf(100);
+    assert(buf.capacity() >= 100 && buf.end() - buf.begin() == static_cast<std::ptrdiff_t>(buf.capacity()));
+
+    // Writes through either half show up in the other.
+    buf.data()[0] = 'a';
+    assert(buf.data()[buf.capacity()] == 'a');
+    buf.data()[2 * buf.capacity() - 1] = 'z';
+    assert(buf.data()[buf.capacity() - 1] == 'z');
+
+    // A ring whose contents wrap is still one contiguous range.
+    const size_t cap = buf.capacity();
+    sg14::ring_span<char> r(buf.begin(), buf.end(), buf.end() - 3, 0);
+    const std::string text = "wrapped!";
+    for (char c : text) {
+        r.push_back(c);
+    }
+    auto rd = r.read_segments(r.size());
+    assert(rd.first.size == 3 && rd.second.size == 5);
+    assert(std::string(&r.front(), r.size()) == text);
+
+    sg14::mirrored_buffer<int> ints(1);
+    assert(ints.capacity() * sizeof(int) % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0);
+    sg14::mirrored_buffer<int> moved(std::move(ints));
+    assert(moved.capacity() != 0 && ints.capacity() == 0 && ints.data() == nullptr);
+    moved.data()[moved.capacity()] = 42;
+    assert(moved.data()[0] == 42);
+    moved = sg14::mirrored_buffer<int>(cap);
+    assert(moved.capacity() >= cap);
+
+    bool threw = false;
+    try {
+        sg14::mirrored_buffer<int> huge(std::numeric_limits<size_t>::max() / 2);
+    } catch (const std::system_error&) {
+        threw = true;
+    }
+    assert(threw);
+#endif
+}
+
+static void spsc_basic_test()
+{
+    std::array<int, 3> A;
+    sg14::spsc_ring_span<int> r(A.begin(), A.end());
+    int x = 0;
+
+    assert(r.empty() && r.capacity() == 3);
+    assert(!r.try_pop(x));
+    assert(r.try_push(1));
+    assert(r.try_emplace(2));
+    int three = 3;
+    assert(r.try_push(three));
+    assert(r.full() && r.size() == 3);
+    assert(!r.try_push(4));
+
+    assert(r.try_pop(x) && x == 1);
+    assert(r.try_push(4));
+    assert(!r.try_push(5));
+    assert(r.try_pop(x) && x == 2);
+    assert(r.try_pop());
+    assert(r.try_pop(x) && x == 4);
+    assert(r.empty());
+
+    // Go around the buffer several times to exercise the counter wrap.
+    for (int i = 0; i < 20; ++i) {
+        assert(r.try_push(i));
+        assert(r.try_push(i + 100));
+        assert(r.size() == 2);
+        assert(r.try_pop(x) && x == i);
+        assert(r.try_pop(x) && x == i + 100);
+    }
+    assert(r.empty());
+}
+
+static void spsc_popper_test()
+{
+    std::vector<std::unique_ptr<int>> v(2);
+    sg14::spsc_ring_span<std::unique_ptr<int>> r(v.begin(), v.end());
+    assert(r.try_push(std::make_unique<int>(1)));
+    assert(r.try_emplace(new int(2)));
+    std::unique_ptr<int> p;
+    assert(r.try_pop(p) && *p == 1);
+    assert(v[0] == nullptr);
+
+    std::vector<std::string> s(2);
+    sg14::spsc_ring_span<std::string, sg14::copy_popper<std::string>> c(s.begin(), s.end(), {"popped"});
+    assert(c.try_emplace("quick"));
+    std::string result;
+    assert(c.try_pop(result) && result == "quick");
+    assert(s[0] == "popped");
+}
+
+static void spsc_threaded_test()
+{
+    const int count = 100000;
+    std::array<int, 64> A;
+    sg14::spsc_ring_span<int> r(A.begin(), A.end());
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ) {
+            if (r.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (int expected = 0; expected < count; ) {
+        int x;
+        if (r.try_pop(x)) {
+            assert(x == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(r.empty());
+}
+
+static void mpmc_basic_test()
+{
+    std::vector<sg14::mpmc_ring_cell<int>> cells(3);
+    sg14::mpmc_ring_span<int> q(cells.begin(), cells.end());
+    int x = 0;
+
+    assert(q.empty() && q.capacity() == 3);
+    assert(!q.try_pop(x));
+    assert(q.try_push(1));
+    assert(q.try_emplace(2));
+    int three = 3;
+    assert(q.try_push(three));
+    assert(q.size() == 3);
+    assert(!q.try_push(4));
+
+    assert(q.try_pop(x) && x == 1);
+    assert(q.try_push(4));
+    assert(q.try_pop(x) && x == 2);
+    assert(q.try_pop());
+    assert(q.try_pop(x) && x == 4);
+    assert(q.empty());
+    assert(!q.try_pop());
+
+    for (int i = 0; i < 20; ++i) {
+        assert(q.try_push(i));
+        assert(q.try_pop(x) && x == i);
+    }
+
+    std::vector<sg14::mpmc_ring_cell<std::string>> strings(2);
+    sg14::mpmc_ring_span<std::string, sg14::copy_popper<std::string>> c(strings.begin(), strings.end(), {"popped"});
+    assert(c.try_emplace("quick"));
+    std::string result;
+    assert(c.try_pop(result) && result == "quick");
+    assert(strings[0].value == "popped");
+
+    // A throwing popper still hands its cell back to the producers.
+    struct throwing_popper {
+        int operator()(int& v) const {
+            if (v < 0) {
+                throw v;
+            }
+            return v;
+        }
+    };
+    std::vector<sg14::mpmc_ring_cell<int>> one(1);
+    sg14::mpmc_ring_span<int, throwing_popper> t(one.begin(), one.end());
+    assert(t.try_push(-1));
+    bool threw = false;
+    try {
+        t.try_pop(x);
+    } catch (int) {
+        threw = true;
+    }
+    assert(threw && t.empty());
+    assert(t.try_push(5));
+    assert(t.try_pop(x) && x == 5);
+}
+
+static void mpmc_threaded_test()
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 20000;
+    std::vector<sg14::mpmc_ring_cell<int>> cells(16);
+    sg14::mpmc_ring_span<int> q(cells.begin(), cells.end());
+
+    // Every value is popped exactly once, and each consumer sees the values
+    // of any one producer in the order they were pushed.
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    for (auto& s : seen) {
+        s.store(0);
+    }
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ) {
+                if (q.try_push(p * per_producer + i)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::atomic<int> popped(0);
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<int> last(producers, -1);
+            while (popped.load() < producers * per_producer) {
+                int x;
+                if (q.try_pop(x)) {
+                    ++popped;
+                    ++seen[x];
+                    assert(x % per_producer > last[x / per_producer]);
+                    last[x / per_producer] = x % per_producer;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto& s : seen) {
+        assert(s.load() == 1);
+    }
+    assert(q.empty());
+}
+
 void sg14_test::ring_test()
 {
     basic_test();
@@ -172,6 +589,15 @@ void sg14_test::ring_test()
     iterator_regression_test();
     copy_popper_test();
     reverse_iterator_test();
+    segments_test();
+    pow2_test();
+    static_ring_test();
+    mirrored_buffer_test();
+    spsc_basic_test();
+    spsc_popper_test();
+    spsc_threaded_test();
+    mpmc_basic_test();
+    mpmc_threaded_test();
 }
 
 #ifdef TEST_MAIN
@@ -1,5 +1,6 @@
 #include "SG14_test.h"
 #include "slot_map.h"
+#include "paged_vector.h"
 #include <assert.h>
 #include <inttypes.h>
 #include <algorithm>
@@ -9,6 +10,7 @@
 #include <iterator>
 #include <memory>
 #include <random>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -286,6 +288,85 @@ static void EraseRangeTest()
     }
 }
 
+template<class SM>
+static void EraseRangeKeysTest()
+{
+    using T = typename SM::mapped_type;
+    using Key = typename SM::key_type;
+    SM sm;
+    std::vector<Key> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back(sm.insert(Monad<T>::from_value(i)));
+    }
+    // The tail block fills the hole in order.
+    auto it = sm.erase(std::next(sm.begin(), 2), std::next(sm.begin(), 4));
+    assert(it == std::next(sm.begin(), 2));
+    std::vector<int> values;
+    for (auto&& value : sm) {
+        values.push_back(static_cast<int>(Monad<T>::value_of(value)));
+    }
+    assert((values == std::vector<int>{0, 1, 8, 9, 4, 5, 6, 7}));
+    for (int i = 0; i < 10; ++i) {
+        if (i == 2 || i == 3) {
+            assert(sm.find(keys[i]) == sm.end());
+        } else {
+            assert(static_cast<int>(Monad<T>::value_of(sm.at(keys[i]))) == i);
+        }
+    }
+
+    // Fewer values follow the range than it holds: the order matches
+    // erasing the range one value at a time from the back.
+    it = sm.erase(std::next(sm.begin(), 3), std::next(sm.begin(), 6));
+    assert(it == std::next(sm.begin(), 3));
+    values.clear();
+    for (auto&& value : sm) {
+        values.push_back(static_cast<int>(Monad<T>::value_of(value)));
+    }
+    assert((values == std::vector<int>{0, 1, 8, 7, 6}));
+    for (int i : {0, 1, 6, 7, 8}) {
+        assert(static_cast<int>(Monad<T>::value_of(sm.at(keys[i]))) == i);
+    }
+    for (int i : {2, 3, 4, 5, 9}) {
+        assert(sm.find(keys[i]) == sm.end());
+    }
+
+    // Every key either expires or still finds its value, whatever the range.
+    for (int first = 0; first < 30; first += 7) {
+        for (int last = first; last <= 30; last += 5) {
+            sm.clear();
+            keys.clear();
+            for (int i = 0; i < 40; ++i) {
+                keys.push_back(sm.insert(Monad<T>::from_value(i)));
+            }
+            for (int i = 0; i < 40; i += 4) {
+                sm.erase(keys[i]);
+            }
+            std::vector<int> erased;
+            for (auto jt = std::next(sm.begin(), first); jt != std::next(sm.begin(), last); ++jt) {
+                erased.push_back(static_cast<int>(Monad<T>::value_of(*jt)));
+            }
+            auto slots = sm.slot_count();
+            sm.erase(std::next(sm.begin(), first), std::next(sm.begin(), last));
+            assert(sm.size() == 30 - static_cast<size_t>(last - first));
+            for (int i = 0; i < 40; ++i) {
+                bool gone = (i % 4 == 0) || std::find(erased.begin(), erased.end(), i) != erased.end();
+                if (gone) {
+                    assert(sm.find(keys[i]) == sm.end());
+                } else {
+                    assert(static_cast<int>(Monad<T>::value_of(sm.at(keys[i]))) == i);
+                }
+            }
+            // The freed slots are reused before any new slot is made.
+            for (int i = 0; i < 10 + last - first; ++i) {
+                Key k = sm.insert(Monad<T>::from_value(100 + i));
+                assert(static_cast<int>(Monad<T>::value_of(sm.at(k))) == 100 + i);
+            }
+            assert(sm.slot_count() == slots);
+            assert(sm.size() == 40);
+        }
+    }
+}
+
 template<class SM>
 static void ReserveTest()
 {
@@ -472,6 +553,279 @@ static void GenerationsDontSkipTest()
 #endif
 }
 
+template<class Key>
+static bool KeysAreEqual(const Key& k1, const Key& k2)
+{
+#if __cplusplus < 201703L
+    using std::get;
+    return get<0>(k1) == get<0>(k2) && get<1>(k1) == get<1>(k2);
+#else
+    auto [idx1, gen1] = k1;
+    auto [idx2, gen2] = k2;
+    return idx1 == idx2 && gen1 == gen2;
+#endif
+}
+
+template<class SM>
+static void BulkInsertTest()
+{
+    using T = typename SM::mapped_type;
+    using K = typename SM::key_type;
+    SM bulk;
+    SM single;
+    std::vector<K> old_keys;
+    for (int i=0; i < 20; ++i) {
+        old_keys.push_back(bulk.emplace(Monad<T>::from_value(i)));
+        single.emplace(Monad<T>::from_value(i));
+    }
+    // Leave a free list that is not in index order.
+    for (int i : { 3, 17, 8, 0, 12 }) {
+        bulk.erase(old_keys[i]);
+        single.erase(old_keys[i]);
+    }
+
+    // The bulk insert must hand out exactly the keys that emplace() would have,
+    // first from the free list and then from new slots.
+    std::vector<T> values;
+    for (int i=0; i < 30; ++i) {
+        values.push_back(Monad<T>::from_value(100 + i));
+    }
+    std::vector<K> bulk_keys;
+    bulk.insert(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()), std::back_inserter(bulk_keys));
+    assert(bulk_keys.size() == 30);
+    assert(bulk.size() == 45);
+    for (int i=0; i < 30; ++i) {
+        auto k = single.emplace(Monad<T>::from_value(100 + i));
+        assert(KeysAreEqual(k, bulk_keys[i]));
+        assert(static_cast<int>(Monad<T>::value_of(bulk[bulk_keys[i]])) == 100 + i);
+    }
+    assert(bulk.slot_count() == single.slot_count());
+    for (int i=0; i < 20; ++i) {
+        bool erased = (i == 3 || i == 17 || i == 8 || i == 0 || i == 12);
+        assert((bulk.find(old_keys[i]) == bulk.end()) == erased);
+    }
+
+    // The keys stay valid through later erasures, and the free list still works afterwards.
+    for (int i=0; i < 30; i += 2) {
+        assert(bulk.erase(bulk_keys[i]) == 1);
+    }
+    assert(bulk.size() == 30);
+    auto k = bulk.emplace(Monad<T>::from_value(7));
+    assert(static_cast<int>(Monad<T>::value_of(bulk[k])) == 7);
+    for (int i=1; i < 30; i += 2) {
+        assert(static_cast<int>(Monad<T>::value_of(bulk[bulk_keys[i]])) == 100 + i);
+    }
+
+    K unused[1];
+    assert(bulk.insert(std::make_move_iterator(values.end()), std::make_move_iterator(values.end()), unused) == unused);
+    assert(bulk.size() == 31);
+}
+
+struct SinglePassIterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+    std::list<int>::const_iterator it;
+    reference operator*() const { return *it; }
+    SinglePassIterator& operator++() { ++it; return *this; }
+    bool operator!=(const SinglePassIterator& rhs) const { return it != rhs.it; }
+};
+
+template<class SM>
+static void InsertNTest()
+{
+    SM sm;
+    std::vector<typename SM::key_type> keys(50);
+    auto k = sm.emplace(1);
+    sm.erase(k);
+    auto out = sm.insert_n(50, 42, keys.begin());
+    assert(out == keys.end());
+    assert(sm.size() == 50);
+    for (auto&& key : keys) {
+        assert(sm.at(key) == 42);
+    }
+    for (int i=1; i < 50; ++i) {
+        assert(!KeysAreEqual(keys[i], keys[i-1]));
+    }
+
+    // The value may be an element of the slot_map itself.
+    sm[keys[0]] = 43;
+    std::vector<typename SM::key_type> alias_keys;
+    sm.insert_n(100, sm[keys[0]], std::back_inserter(alias_keys));
+    assert(sm.size() == 150);
+    for (auto&& key : alias_keys) {
+        assert(sm.at(key) == 43);
+    }
+    {
+        stdext::slot_map<std::string> ssm;
+        auto skey = ssm.emplace(40, 'x');
+        std::vector<stdext::slot_map<std::string>::key_type> skeys;
+        ssm.insert_n(5, *ssm.begin(), std::back_inserter(skeys));
+        assert(ssm.size() == 6);
+        for (auto&& key : skeys) {
+            assert(ssm.at(key) == ssm.at(skey));
+        }
+    }
+    for (auto&& key : alias_keys) {
+        sm.erase(key);
+    }
+    sm[keys[0]] = 42;
+
+    // Single-pass input ranges are inserted too.
+    std::list<int> input_values = { 5, 6, 7 };
+    std::vector<typename SM::key_type> more_keys;
+    sm.insert(SinglePassIterator{input_values.begin()}, SinglePassIterator{input_values.end()}, std::back_inserter(more_keys));
+    assert(sm.size() == 53);
+    assert(more_keys.size() == 3);
+    assert(sm[more_keys[2]] == 7);
+}
+
+template<class SM>
+static void FindManyTest()
+{
+    using T = typename SM::mapped_type;
+    using Key = typename SM::key_type;
+    SM sm;
+    std::vector<Key> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(sm.emplace(Monad<T>::from_value(i)));
+    }
+    std::vector<Key> expired;
+    for (int i = 0; i < 100; i += 3) {
+        expired.push_back(keys[i]);
+        sm.erase(keys[i]);
+    }
+    // Mix live keys, expired keys, and a key past the last slot, in an
+    // order unrelated to the values.
+    std::vector<Key> batch;
+    for (int i = 99; i >= 0; --i) {
+        batch.push_back(keys[(i * 37) % 100]);
+    }
+    Key out_of_range = keys[0];
+#if __cplusplus < 201703L
+    using std::get;
+    get<0>(out_of_range) = 1000;
+#else
+    auto& [idx, gen] = out_of_range;
+    idx = 1000;
+    (void)gen;
+#endif
+    batch.push_back(out_of_range);
+
+    std::vector<T*> ptrs(batch.size() + 1);
+    auto end = sm.find_many(batch.begin(), batch.end(), ptrs.begin());
+    assert(end == ptrs.begin() + batch.size());
+    for (size_t i = 0; i != batch.size(); ++i) {
+        auto it = sm.find(batch[i]);
+        if (it == sm.end()) {
+            assert(ptrs[i] == nullptr);
+        } else {
+            assert(ptrs[i] == std::addressof(*it));
+        }
+    }
+
+    const SM& csm = sm;
+    std::vector<const T*> cptrs;
+    csm.find_many(expired.begin(), expired.end(), std::back_inserter(cptrs));
+    assert(cptrs.size() == expired.size());
+    assert(std::count(cptrs.begin(), cptrs.end(), nullptr) == static_cast<std::ptrdiff_t>(expired.size()));
+
+    // for_each_key visits the live keys in the order given, through a
+    // forward-only range too.
+    std::vector<int> visited;
+    std::forward_list<Key> flist(batch.begin(), batch.end());
+    auto found = sm.for_each_key(flist.begin(), flist.end(), [&](T& value) {
+        visited.push_back(static_cast<int>(Monad<T>::value_of(value)));
+    });
+    assert(found == sm.size());
+    assert(visited.size() == sm.size());
+    size_t v = 0;
+    for (auto&& key : batch) {
+        auto it = sm.find(key);
+        if (it != sm.end()) {
+            assert(visited[v++] == static_cast<int>(Monad<T>::value_of(*it)));
+        }
+    }
+    found = csm.for_each_key(batch.begin(), batch.begin() + 3, [](const T&) {});
+    assert(found <= 3);
+}
+
+template<class SM>
+static void SortPartitionTest()
+{
+    using T = typename SM::mapped_type;
+    using Key = typename SM::key_type;
+    SM sm;
+    std::vector<Key> keys;
+    for (int i = 0; i < 60; ++i) {
+        keys.push_back(sm.insert(Monad<T>::from_value((i * 7) % 60)));
+    }
+    // Churn, so that values_ is out of insertion order.
+    for (int i = 0; i < 60; i += 5) {
+        sm.erase(keys[i]);
+    }
+    auto value_at = [&](int i) { return static_cast<int>(Monad<T>::value_of(sm.at(keys[i]))); };
+    auto check_keys = [&]() {
+        for (int i = 0; i < 60; ++i) {
+            if (i % 5 == 0) {
+                assert(sm.find(keys[i]) == sm.end());
+            } else {
+                assert(value_at(i) == (i * 7) % 60);
+            }
+        }
+    };
+    auto values = [&]() {
+        std::vector<int> result;
+        for (auto&& value : sm) {
+            result.push_back(static_cast<int>(Monad<T>::value_of(value)));
+        }
+        return result;
+    };
+
+    sm.sort([](const T& a, const T& b) { return Monad<T>::value_of(a) > Monad<T>::value_of(b); });
+    auto sorted = values();
+    assert(sorted.size() == 48);
+    assert(std::is_sorted(sorted.rbegin(), sorted.rend()));
+    check_keys();
+
+    auto is_even = [](const T& v) { return Monad<T>::value_of(v) % 2 == 0; };
+    auto mid = sm.partition(is_even);
+    auto partitioned = values();
+    auto evens = std::count_if(partitioned.begin(), partitioned.end(), [](int v) { return v % 2 == 0; });
+    assert(std::distance(sm.begin(), mid) == evens);
+    assert(std::all_of(sm.begin(), mid, is_even));
+    assert(std::none_of(mid, sm.end(), is_even));
+    check_keys();
+
+    // The free list survives: the erased slots are reused.
+    auto slots = sm.slot_count();
+    for (int i = 0; i < 12; ++i) {
+        keys[i * 5] = sm.insert(Monad<T>::from_value((i * 5 * 7) % 60));
+    }
+    assert(sm.slot_count() == slots);
+    for (int i = 0; i < 60; ++i) {
+        assert(value_at(i) == (i * 7) % 60);
+    }
+    sm.sort([](const T& a, const T& b) { return Monad<T>::value_of(a) < Monad<T>::value_of(b); });
+    sorted = values();
+    for (int i = 0; i < 60; ++i) {
+        assert(sorted[i] == i);
+    }
+
+    // A throwing comparison leaves everything in place.
+    auto before = values();
+    try {
+        sm.sort([](const T&, const T&) -> bool { throw 42; });
+        assert(false);
+    } catch (int) {}
+    assert(values() == before);
+    sm.clear();
+    sm.sort([](const T&, const T&) { return false; });
+    assert(sm.partition(is_even) == sm.end());
+}
+
 template<class SM>
 static void IndexesAreUsedEvenlyTest()
 {
@@ -508,6 +862,190 @@ static void IndexesAreUsedEvenlyTest()
 #endif
 }
 
+template<class SM>
+static void SoaBasicTest()
+{
+    SM sm;
+    assert(sm.empty());
+    auto k1 = sm.insert(1, 1.5);
+    auto k2 = sm.insert(2, 2.5);
+    auto k3 = sm.insert(3, 3.5);
+    assert(sm.size() == 3);
+    assert(sm.find(k2) == 1);
+    assert(sm.template at<0>(k2) == 2);
+    assert(sm.template at<1>(k2) == 2.5);
+    assert(sm.template get<1>(k3) == 3.5);
+    assert(KeysAreEqual(sm.key_at(2), k3));
+
+    // Erasing moves the last values of both columns into the hole.
+    assert(sm.erase(k1) == 1);
+    assert(sm.size() == 2);
+    assert(!sm.contains(k1));
+    assert(sm.find(k1) == sm.size());
+    try { (void)sm.template at<0>(k1); assert(false); } catch (const std::out_of_range&) {}
+    assert(sm.find(k3) == 0);
+    assert(sm.template at<0>(k3) == 3 && sm.template at<1>(k3) == 3.5);
+    assert(KeysAreEqual(sm.key_at(0), k3));
+    assert(KeysAreEqual(sm.key_at(1), k2));
+    assert(sm.erase(k1) == 0);
+
+    // The freed slot is reused, with a new generation.
+    auto k4 = sm.insert(4, 4.5);
+    assert(!KeysAreEqual(k4, k1));
+    assert(!sm.contains(k1));
+    assert(sm.template at<1>(k4) == 4.5);
+
+    SM sm2;
+    sm.swap(sm2);
+    assert(sm.empty());
+    assert(sm2.size() == 3);
+    sm2.clear();
+    assert(sm2.empty());
+    assert(sm2.slot_count() == 0);
+}
+
+template<class SM>
+static void SoaStressTest()
+{
+    using Key = typename SM::key_type;
+    std::mt19937 g;
+    SM sm;
+    sm.reserve(50);
+    std::vector<std::pair<Key, int>> live;
+    for (int i = 0; i < 1000; ++i) {
+        if (live.empty() || g() % 3 != 0) {
+            live.emplace_back(sm.insert(i, static_cast<double>(i) / 2), i);
+        } else {
+            size_t victim = g() % live.size();
+            assert(sm.erase(live[victim].first) == 1);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+        assert(sm.size() == live.size());
+    }
+    for (auto&& kv : live) {
+        assert(sm.template at<0>(kv.first) == kv.second);
+        assert(sm.template at<1>(kv.first) == static_cast<double>(kv.second) / 2);
+    }
+    // Every column is in the same order.
+    for (typename SM::size_type pos = 0; pos != sm.size(); ++pos) {
+        auto key = sm.key_at(pos);
+        assert(sm.find(key) == pos);
+        assert(sm.template get<1>(key) == static_cast<double>(sm.template get<0>(key)) / 2);
+    }
+}
+
+template<class SM, class = void>
+struct HasColumn : std::false_type {};
+template<class SM>
+struct HasColumn<SM, decltype(void(std::declval<SM&>().template column<0>()))> : std::true_type {};
+
+static void SoaColumnTest()
+{
+    stdext::slot_map_soa<std::pair<unsigned, unsigned>, float, float> sm;
+    std::vector<std::pair<unsigned, unsigned>> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back(sm.insert(static_cast<float>(i), 1.0f));
+    }
+    sm.erase(keys[3]);
+    auto x = sm.column<0>();
+    auto vx = sm.column<1>();
+    assert(x.size() == 9 && vx.size() == 9);
+    for (size_t i = 0; i != x.size(); ++i) {
+        x[i] += vx[i];
+    }
+    assert(sm.at<0>(keys[9]) == 10.0f);
+    assert(sm.at<0>(keys[0]) == 1.0f);
+    const auto& csm = sm;
+    float sum = 0;
+    for (float f : csm.column<0>()) {
+        sum += f;
+    }
+    assert(sum == 55.0f - 4.0f);
+}
+
+struct ThrowsOnCopy {
+    static bool armed;
+    int value;
+    explicit ThrowsOnCopy(int v) : value(v) {}
+    ThrowsOnCopy(const ThrowsOnCopy& rhs) : value(rhs.value) { if (armed) throw 42; }
+    ThrowsOnCopy(ThrowsOnCopy&&) noexcept = default;
+    ThrowsOnCopy& operator=(const ThrowsOnCopy&) = default;
+    ThrowsOnCopy& operator=(ThrowsOnCopy&&) noexcept = default;
+};
+bool ThrowsOnCopy::armed = false;
+
+static void SoaInsertThrowsTest()
+{
+    stdext::slot_map_soa<std::pair<unsigned, unsigned>, int, ThrowsOnCopy> sm;
+    auto k1 = sm.insert(1, ThrowsOnCopy(1));
+    const ThrowsOnCopy t(2);
+    ThrowsOnCopy::armed = true;
+    try { sm.insert(2, t); assert(false); } catch (int) {}
+    ThrowsOnCopy::armed = false;
+    assert(sm.size() == 1);
+    assert(sm.column<0>().size() == 1 && sm.column<1>().size() == 1);
+    assert(sm.at<1>(k1).value == 1);
+    auto k2 = sm.insert(2, t);
+    assert(sm.find(k2) == 1);
+}
+
+// A deque (so there is no reserve()) whose emplace_back() throws once the
+// countdown, shared by every element type, reaches zero.
+struct EmplaceCountdown {
+    static int remaining;
+};
+int EmplaceCountdown::remaining = -1;
+
+template<class T>
+struct ThrowingDeque : std::deque<T> {
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        if (EmplaceCountdown::remaining >= 0 && EmplaceCountdown::remaining-- == 0) {
+            throw 42;
+        }
+        std::deque<T>::emplace_back(std::forward<Args>(args)...);
+    }
+};
+
+static void BulkInsertThrowsTest()
+{
+    using SM = stdext::slot_map<int, std::pair<unsigned, unsigned>, ThrowingDeque>;
+    SM sm;
+    std::vector<SM::key_type> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back(sm.insert(i));
+    }
+    sm.erase(keys[2]);
+    sm.erase(keys[7]);
+
+    // Fail at every emplace_back of the values, the reverse map and the new slots in turn.
+    const std::vector<int> values = { 10, 11, 12, 13, 14 };
+    for (int countdown = 0; ; ++countdown) {
+        std::vector<SM::key_type> new_keys;
+        EmplaceCountdown::remaining = countdown;
+        try {
+            sm.insert(values.begin(), values.end(), std::back_inserter(new_keys));
+        } catch (int) {
+            EmplaceCountdown::remaining = -1;
+            assert(sm.size() == 8 && sm.slot_count() == 10);
+            for (int i = 0; i < 10; ++i) {
+                assert((i == 2 || i == 7) ? sm.find(keys[i]) == sm.end() : sm.at(keys[i]) == i);
+            }
+            continue;
+        }
+        EmplaceCountdown::remaining = -1;
+        assert(countdown == 13);
+        assert(sm.size() == 13 && sm.slot_count() == 13);
+        for (int i = 0; i < 5; ++i) {
+            assert(sm.at(new_keys[i]) == 10 + i);
+        }
+        break;
+    }
+    auto k = sm.insert(20);
+    assert(sm.at(k) == 20 && sm.slot_count() == 14);
+}
+
 void sg14_test::slot_map_test()
 {
     TypedefTests();
@@ -521,10 +1059,16 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_1>([i=3]() mutable { return ++i; });
     EraseInLoopTest<slot_map_1>();
     EraseRangeTest<slot_map_1>();
+    EraseRangeKeysTest<slot_map_1>();
     ReserveTest<slot_map_1>();
     VerifyCapacityExists<slot_map_1>(true);
     GenerationsDontSkipTest<slot_map_1>();
     IndexesAreUsedEvenlyTest<slot_map_1>();
+    SortPartitionTest<slot_map_1>();
+    FindManyTest<slot_map_1>();
+    BulkInsertTest<slot_map_1>();
+    InsertNTest<slot_map_1>();
+    BulkInsertThrowsTest();
 
     // Test slot_map with a custom key type (C++14 destructuring).
     using slot_map_2 = stdext::slot_map<unsigned long, TestKey::key_16_8_t>;
@@ -534,10 +1078,15 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_2>([i=5]() mutable { return ++i; });
     EraseInLoopTest<slot_map_2>();
     EraseRangeTest<slot_map_2>();
+    EraseRangeKeysTest<slot_map_2>();
     ReserveTest<slot_map_2>();
     VerifyCapacityExists<slot_map_2>(true);
     GenerationsDontSkipTest<slot_map_2>();
     IndexesAreUsedEvenlyTest<slot_map_2>();
+    SortPartitionTest<slot_map_2>();
+    FindManyTest<slot_map_2>();
+    BulkInsertTest<slot_map_2>();
+    InsertNTest<slot_map_2>();
 
 #if __cplusplus >= 201703L
     // Test slot_map with a custom key type (C++17 destructuring).
@@ -548,10 +1097,15 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_3>([i=3]() mutable { return ++i; });
     EraseInLoopTest<slot_map_3>();
     EraseRangeTest<slot_map_3>();
+    EraseRangeKeysTest<slot_map_3>();
     ReserveTest<slot_map_3>();
     VerifyCapacityExists<slot_map_3>(true);
     GenerationsDontSkipTest<slot_map_3>();
     IndexesAreUsedEvenlyTest<slot_map_3>();
+    SortPartitionTest<slot_map_3>();
+    FindManyTest<slot_map_3>();
+    BulkInsertTest<slot_map_3>();
+    InsertNTest<slot_map_3>();
 #endif // __cplusplus >= 201703L
 
     // Test slot_map with a custom (but standard and random-access) container type.
@@ -562,10 +1116,15 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_4>([i=7]() mutable { return ++i; });
     EraseInLoopTest<slot_map_4>();
     EraseRangeTest<slot_map_4>();
+    EraseRangeKeysTest<slot_map_4>();
     ReserveTest<slot_map_4>();
     VerifyCapacityExists<slot_map_4>(false);
     GenerationsDontSkipTest<slot_map_4>();
     IndexesAreUsedEvenlyTest<slot_map_4>();
+    SortPartitionTest<slot_map_4>();
+    FindManyTest<slot_map_4>();
+    BulkInsertTest<slot_map_4>();
+    InsertNTest<slot_map_4>();
 
     // Test slot_map with a custom (non-standard, random-access) container type.
     using slot_map_5 = stdext::slot_map<int, std::pair<unsigned, unsigned>, TestContainer::Vector>;
@@ -576,10 +1135,15 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_5>([i=7]() mutable { return ++i; });
     EraseInLoopTest<slot_map_5>();
     EraseRangeTest<slot_map_5>();
+    EraseRangeKeysTest<slot_map_5>();
     ReserveTest<slot_map_5>();
     VerifyCapacityExists<slot_map_5>(false);
     GenerationsDontSkipTest<slot_map_5>();
     IndexesAreUsedEvenlyTest<slot_map_5>();
+    SortPartitionTest<slot_map_5>();
+    FindManyTest<slot_map_5>();
+    BulkInsertTest<slot_map_5>();
+    InsertNTest<slot_map_5>();
 
     // Test slot_map with a custom (standard, bidirectional-access) container type.
     using slot_map_6 = stdext::slot_map<int, std::pair<unsigned, unsigned>, std::list>;
@@ -591,10 +1155,15 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_6>([i=7]() mutable { return ++i; });
     EraseInLoopTest<slot_map_6>();
     EraseRangeTest<slot_map_6>();
+    EraseRangeKeysTest<slot_map_6>();
     ReserveTest<slot_map_6>();
     VerifyCapacityExists<slot_map_6>(false);
     GenerationsDontSkipTest<slot_map_6>();
     IndexesAreUsedEvenlyTest<slot_map_6>();
+    SortPartitionTest<slot_map_6>();
+    FindManyTest<slot_map_6>();
+    BulkInsertTest<slot_map_6>();
+    InsertNTest<slot_map_6>();
 
     // Test slot_map with a move-only value_type.
     // Sadly, standard containers do not propagate move-only-ness, so we must use our custom Vector instead.
@@ -609,10 +1178,54 @@ void sg14_test::slot_map_test()
     InsertEraseStressTest<slot_map_7>([i=7]() mutable { return std::make_unique<int>(++i); });
     EraseInLoopTest<slot_map_7>();
     EraseRangeTest<slot_map_7>();
+    EraseRangeKeysTest<slot_map_7>();
     ReserveTest<slot_map_7>();
     VerifyCapacityExists<slot_map_7>(false);
     GenerationsDontSkipTest<slot_map_7>();
     IndexesAreUsedEvenlyTest<slot_map_7>();
+    SortPartitionTest<slot_map_7>();
+    FindManyTest<slot_map_7>();
+    BulkInsertTest<slot_map_7>();
+
+    // Test slot_map with the library's paged container.
+    using slot_map_8 = stdext::slot_map<int, std::pair<unsigned, unsigned>, stdext::paged_vector>;
+    static_assert(std::is_nothrow_move_constructible<slot_map_8>::value, "paged_vector is nothrow-movable");
+    BasicTests<slot_map_8>(415, 315);
+    BoundsCheckingTest<slot_map_8>();
+    FullContainerStressTest<slot_map_8>([]() { return 37; });
+    InsertEraseStressTest<slot_map_8>([i=7]() mutable { return ++i; });
+    EraseInLoopTest<slot_map_8>();
+    EraseRangeTest<slot_map_8>();
+    EraseRangeKeysTest<slot_map_8>();
+    ReserveTest<slot_map_8>();
+    VerifyCapacityExists<slot_map_8>(true);
+    GenerationsDontSkipTest<slot_map_8>();
+    IndexesAreUsedEvenlyTest<slot_map_8>();
+    SortPartitionTest<slot_map_8>();
+    FindManyTest<slot_map_8>();
+    BulkInsertTest<slot_map_8>();
+    InsertNTest<slot_map_8>();
+
+    // Test the structure-of-arrays slot_map.
+    using slot_map_soa_1 = stdext::slot_map_soa<std::pair<unsigned, unsigned>, int, double>;
+    static_assert(HasColumn<slot_map_soa_1>::value, "vector columns are contiguous");
+    SoaBasicTest<slot_map_soa_1>();
+    SoaStressTest<slot_map_soa_1>();
+    SoaColumnTest();
+    SoaInsertThrowsTest();
+
+    using slot_map_soa_2 = stdext::slot_map_soa<TestKey::key_16_8_t, int, double>;
+    SoaBasicTest<slot_map_soa_2>();
+    SoaStressTest<slot_map_soa_2>();
+
+    using slot_map_soa_3 = stdext::basic_slot_map_soa<std::pair<unsigned, unsigned>, std::deque, int, double>;
+    static_assert(!HasColumn<slot_map_soa_3>::value, "deque columns are not contiguous");
+    SoaBasicTest<slot_map_soa_3>();
+    SoaStressTest<slot_map_soa_3>();
+
+    using slot_map_soa_4 = stdext::basic_slot_map_soa<std::pair<unsigned, unsigned>, TestContainer::Vector, int, double>;
+    SoaBasicTest<slot_map_soa_4>();
+    SoaStressTest<slot_map_soa_4>();
 }
 
 #if defined(__cpp_concepts)
@@ -647,6 +1260,7 @@ concept bool SlotMapContainer =
 static_assert(SlotMapContainer<std::vector>);
 static_assert(SlotMapContainer<std::deque>);
 static_assert(SlotMapContainer<std::list>);
+static_assert(SlotMapContainer<stdext::paged_vector>);
 static_assert(not SlotMapContainer<std::forward_list>);
 static_assert(not SlotMapContainer<std::pair>);
 #endif  // defined(__cpp_concepts)